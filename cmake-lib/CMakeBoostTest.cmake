@@ -61,7 +61,7 @@ function(boost_test_project)
 
         message("Found test: ${PARSED_ARGS_NAME}.${TEST_NAME}")
         add_test(NAME "${PARSED_ARGS_NAME}.${TEST_NAME}"
-                 COMMAND ${CMAKE_BINARY_DIR}/${PARSED_ARGS_NAME}
+                 COMMAND ${PARSED_ARGS_NAME}
                  --run_test=${TEST_SUITE_NAME}/${TEST_NAME} --catch_system_error=yes)
     endforeach()
 endfunction(boost_test_project)
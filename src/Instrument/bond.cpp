@@ -4,71 +4,140 @@
 #include <algorithm>    // For algorithms like std::generate
 #include <iomanip>      // For controlling the output format
 #include "actual_360.hpp"
+#include "fast_math.hpp"
 #include <boost/date_time/gregorian/gregorian.hpp>
 
 
       Bond::Bond(const InstrumentDescription& desc)
     : issueDate(desc.issueDate), maturity(desc.maturity), couponRate(desc.couponRate),
       frequency(desc.frequency), notional(desc.notional),
-      couponDates(desc.couponDates), zeroCouponCurve(desc.zeroCouponCurve) {}
+      couponDates(desc.couponDates), zeroCouponCurve(desc.zeroCouponCurve),
+      curveHandle(desc.curveHandle), curveRegistry(desc.curveRegistry) {
+    if (curveRegistry) discountId = curveRegistry->intern(desc.discountCurve);
+
+    // Mismos tiempos que price(): se redondea a días y se cuenta ACT/360
+    Actual_360 calculator;
+    for (double date : couponDates) {
+        boost::gregorian::date paymentDate = issueDate + boost::gregorian::days(static_cast<int>(date * 360));
+        cashflowTimes.push_back(static_cast<double>(calculator.compute_daycount(issueDate, paymentDate)) / 360.0);
+        cashflowAmounts.push_back((couponRate / frequency) * notional);
+    }
+    boost::gregorian::date maturityDate = issueDate + boost::gregorian::days(static_cast<int>(maturity * 360));
+    cashflowTimes.push_back(static_cast<double>(calculator.compute_daycount(issueDate, maturityDate)) / 360.0);
+    cashflowAmounts.push_back(notional);
+}
+
+void Bond::cashflows(const ZeroCouponCurve&, CashflowBuffer& buffer) const {
+    // Un bono construido por defecto no tiene flujos
+    if (cashflowTimes.empty()) return;
+
+    // El último flujo precalculado es el principal
+    std::size_t coupons = cashflowTimes.size() - 1;
+    for (std::size_t i = 0; i < coupons; ++i) {
+        double t = cashflowTimes[i];
+        buffer.add(t, cashflowAmounts[i],
+                   {CashflowLeg::Fixed, notional, 1.0 / frequency, couponRate, t, t, false});
+    }
+    double t = cashflowTimes.back();
+    buffer.add(t, cashflowAmounts.back(), {CashflowLeg::Principal, notional, 0.0, 0.0, t, t, false});
+}
+
     /**
      * Compute the theoretical price of the bond using discount factors.
      * @return The computed bond price.
      */
     double Bond::price() const {
+    if (curveRegistry) {
+        CurveHandle::ReadGuard guard(curveRegistry->handle(discountId));
+        return price(guard.curve());
+    }
+    if (curveHandle) {
+        // Toda la valoración usa la misma curva aunque se publique otra en paralelo
+        CurveHandle::ReadGuard guard(*curveHandle);
+        return price(guard.curve());
+    }
+    return price(*zeroCouponCurve);
+}
+
+    /**
+     * Compute the theoretical price of the bond against an explicit curve.
+     * @param curve Discount curve.
+     * @return The computed bond price.
+     */
+    double Bond::price(const ZeroCouponCurve& curve) const {
+    // Se recorren los flujos precalculados: sin trazas no se reserva memoria
     double price = 0.0;
-    Actual_360 calculator;
+    if (cashflowTimes.empty()) return price;
+
+    std::size_t coupons = cashflowTimes.size() - 1;
+
+    if (verbose_) {
+        std::cout << "\nMaturity: " << std::setprecision(2) << maturity << " años | Cupón Rate: " 
+                  << std::setprecision(2) << couponRate * 100 << "% | Frecuencia: " 
+                  << std::setprecision(0) << frequency << " pagos por año | Notional: $" << notional << "\n";
+        std::cout << std::string(95, '-') << "\n";
+        std::cout << "\nCalculando Precio Teórico del Bono\n";
+        std::cout << "Formula: Σ(Cupón * DF) + (Notional * DF Final)\n";
+        std::cout << "\nPeriodo | Fecha Pago | Maturity | Cupón | Discount Factor | Cupón Descontado | Precio acumulado\n";
+        std::cout << std::string(95, '-') << "\n";
+    }
 
-    std::cout << "\nMaturity: " << std::setprecision(2) << maturity << " años | Cupón Rate: " 
-              << std::setprecision(2) << couponRate * 100 << "% | Frecuencia: " 
-              << std::setprecision(0) << frequency << " pagos por año | Notional: $" << notional << "\n";
-    std::cout << std::string(95, '-') << "\n";
-    std::cout << "\nCalculando Precio Teórico del Bono\n";
-    std::cout << "Formula: Σ(Cupón * DF) + (Notional * DF Final)\n";
-    std::cout << "\nPeriodo | Fecha Pago | Maturity | Cupón | Discount Factor | Cupón Descontado | Precio acumulado\n";
-    std::cout << std::string(95, '-') << "\n";
-
-    for (size_t i = 0; i < couponDates.size(); ++i) {
-        double date = couponDates[i];
-        boost::gregorian::date payment_date = issueDate + boost::gregorian::days(static_cast<int>(date * 360));
-        double accrualFraction = static_cast<double>(calculator.compute_daycount(issueDate, payment_date)) / 360.0;
-
-        double discountFactor = zeroCouponCurve->getDiscountFactor(accrualFraction);
-        double coupon = (couponRate / frequency) * notional;
+    for (size_t i = 0; i < coupons; ++i) {
+        double accrualFraction = cashflowTimes[i];
+        double discountFactor = curve.getDiscountFactor(accrualFraction);
+        double coupon = cashflowAmounts[i];
         double discountedCashFlow = coupon * discountFactor;
 
         price += discountedCashFlow;
 
-        std::cout << std::setw(7) << (i+1) << " | "
-                  << payment_date << " | "
-                  << std::fixed << std::setprecision(6) << accrualFraction << " | "
-                  << std::setw(6) << std::setprecision(2) << coupon << " | "
-                  << std::setw(15) << std::setprecision(5) << discountFactor << " | "
-                  << std::setw(16) << std::setprecision(5) << discountedCashFlow << " | "
-                  << std::setw(16) << std::setprecision(5) << price << "\n";
+        if (verbose_) {
+            boost::gregorian::date payment_date = issueDate + boost::gregorian::days(static_cast<int>(couponDates[i] * 360));
+            std::cout << std::setw(7) << (i+1) << " | "
+                      << payment_date << " | "
+                      << std::fixed << std::setprecision(6) << accrualFraction << " | "
+                      << std::setw(6) << std::setprecision(2) << coupon << " | "
+                      << std::setw(15) << std::setprecision(5) << discountFactor << " | "
+                      << std::setw(16) << std::setprecision(5) << discountedCashFlow << " | "
+                      << std::setw(16) << std::setprecision(5) << price << "\n";
+        }
     }
 
     // Flujo final: notional descontado
-    boost::gregorian::date maturityDate = issueDate + boost::gregorian::days(static_cast<int>(maturity * 360));
-    double finalAccrualFraction = static_cast<double>(calculator.compute_daycount(issueDate, maturityDate)) / 360.0;
-    double finalDiscount = zeroCouponCurve->getDiscountFactor(finalAccrualFraction);
+    double finalAccrualFraction = cashflowTimes.back();
+    double finalDiscount = curve.getDiscountFactor(finalAccrualFraction);
     double finalDiscountedPayment = notional * finalDiscount;
 
     price += finalDiscountedPayment;
 
-    std::cout << std::setw(7) << "Final" << " | "
-              << maturityDate << " | "
-              << std::fixed << std::setprecision(6) << finalAccrualFraction << " | "
-              << std::setw(6) << std::setprecision(2) << notional << " | "
-              << std::setw(15) << std::setprecision(5) << finalDiscount << " | "
-              << std::setw(16) << std::setprecision(5) << finalDiscountedPayment << " | "
-              << std::setw(16) << std::setprecision(5) << price << "\n";
+    if (verbose_) {
+        boost::gregorian::date maturityDate = issueDate + boost::gregorian::days(static_cast<int>(maturity * 360));
+        std::cout << std::setw(7) << "Final" << " | "
+                  << maturityDate << " | "
+                  << std::fixed << std::setprecision(6) << finalAccrualFraction << " | "
+                  << std::setw(6) << std::setprecision(2) << notional << " | "
+                  << std::setw(15) << std::setprecision(5) << finalDiscount << " | "
+                  << std::setw(16) << std::setprecision(5) << finalDiscountedPayment << " | "
+                  << std::setw(16) << std::setprecision(5) << price << "\n";
 
-    std::cout << std::string(95, '-') << "\n";
-    std::cout << "Precio Total del Bono (Suma de flujos descontados): $" << std::fixed << std::setprecision(5) << price << "\n";
+        std::cout << std::string(95, '-') << "\n";
+        std::cout << "Precio Total del Bono (Suma de flujos descontados): $" << std::fixed << std::setprecision(5) << price << "\n";
+    }
 
     return price;
 }
+
+CurveStamp Bond::curveStamp() const {
+    if (curveRegistry) {
+        CurveHandle::ReadGuard guard(curveRegistry->handle(discountId));
+        return {guard.curve().version(), 0};
+    }
+    if (curveHandle) {
+        CurveHandle::ReadGuard guard(*curveHandle);
+        return {guard.curve().version(), 0};
+    }
+    return {zeroCouponCurve->version(), 0};
+}
+
 double Bond::yieldToMaturity(double initialGuess, int maxIterations, double tolerance, double priceBond) const {
     double estimatedYTM = initialGuess;  
 
@@ -93,7 +162,7 @@ double Bond::yieldToMaturity(double initialGuess, int maxIterations, double tole
             double accrualFraction = static_cast<double>(calculator.compute_daycount(issueDate, payment_date)) / 360.0;
 
             // Calcular el factor de descuento manualmente
-            double discountFactor = 1.0 / pow(1.0 + estimatedYTM / frequency, accrualFraction * frequency);
+            double discountFactor = 1.0 / fastmath::pow(1.0 + estimatedYTM / frequency, accrualFraction * frequency);
             
             functionValue += coupon * discountFactor;
             derivativeValue += -accrualFraction * coupon * discountFactor / (1.0 + estimatedYTM / frequency);
@@ -101,7 +170,7 @@ double Bond::yieldToMaturity(double initialGuess, int maxIterations, double tole
 
         // Agregar el valor nominal descontado
         double finalAccrualFraction = static_cast<double>(calculator.compute_daycount(issueDate, issueDate + boost::gregorian::days(static_cast<int>(maturity * 360)))) / 360.0;
-        double finalDiscountFactor = 1.0 / pow(1.0 + estimatedYTM / frequency, finalAccrualFraction * frequency);
+        double finalDiscountFactor = 1.0 / fastmath::pow(1.0 + estimatedYTM / frequency, finalAccrualFraction * frequency);
         
         functionValue += notional * finalDiscountFactor;
         derivativeValue += -finalAccrualFraction * notional * finalDiscountFactor / (1.0 + estimatedYTM / frequency);
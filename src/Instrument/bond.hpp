@@ -7,13 +7,53 @@
 #include "instrument.hpp"  
 #include "zero_coupon_curve.hpp"  
 #include "instrument_description.hpp"
+#include "pricing_kernels.hpp"
+#include "cashflow.hpp"
 
-class Bond : public Instrument {
+// Precio y sensibilidades del bono frente a un spread continuo s aplicado en
+// el tiempo de cada flujo (DF(t) -> DF(t) * exp(-s t), ver SpreadCurve). No es
+// un desplazamiento de las tasas de los pilares: con flujos entre pilares o
+// tras el último, la interpolación de la curva no mueve DF(t) en -t * DF(t).
+struct BondRisk {
+    double price;
+    double macaulayDuration;   // Σ t * PV(t) / P
+    double modifiedDuration;   // -(1/P) dP/ds (en capitalización continua coincide con Macaulay)
+    double convexity;          // (1/P) d²P/ds²
+    double dv01;               // Cambio de precio por -1pb
+};
+
+class Bond final : public Instrument {
 public:
     Bond() = default;  
     Bond(const InstrumentDescription& description);
 
     double price() const;
+    double price(const ZeroCouponCurve& curve) const;
+    CurveStamp curveStamp() const override;
+    // Cupones y principal; el bono no tiene flujos proyectados
+    void cashflows(const ZeroCouponCurve& forwardCurve, CashflowBuffer& buffer) const override;
+
+    // Precio sin imprimir, contra cualquier curva (ver discount_curve.hpp)
+    template<typename Curve>
+    double presentValue(const Curve& curve) const {
+        return discountedSum(curve, cashflowTimes, cashflowAmounts);
+    }
+
+    // Valor a un horizonte (en años) con la curva vista desde esa fecha:
+    // los tiempos de los flujos se desplazan y los ya pagados se descartan
+    template<typename Curve>
+    HorizonValue valueAt(const Curve& curve, double horizon) const {
+        return discountedSumAt(curve, cashflowTimes, cashflowAmounts, horizon);
+    }
+
+    // Precio y riesgo en una sola pasada sobre los flujos, sin imprimir
+    template<typename Curve>
+    BondRisk risk(const Curve& curve) const;
+
+    // Flujos precalculados (tiempo ACT/360 e importe, el último incluye el principal)
+    const std::vector<double>& getCashflowTimes() const { return cashflowTimes; }
+    const std::vector<double>& getCashflowAmounts() const { return cashflowAmounts; }
+
     double yieldToMaturity(double initialGuess, int maxIterations, double tolerance, double priceBond) const;  
 
 private:
@@ -23,7 +63,27 @@ private:
     double frequency;
     double notional;
     std::vector<double> couponDates;
+    // Flujos precalculados: tiempo (ACT/360) e importe, incluido el principal
+    std::vector<double> cashflowTimes;
+    std::vector<double> cashflowAmounts;
     std::shared_ptr<ZeroCouponCurve> zeroCouponCurve;  
+    std::shared_ptr<CurveHandle> curveHandle;
+    std::shared_ptr<CurveRegistry> curveRegistry;
+    CurveRegistry::CurveId discountId = 0;
 };
 
+template<typename Curve>
+BondRisk Bond::risk(const Curve& curve) const {
+    // dPV/ds = -t * PV y d²PV/ds² = t² * PV: se acumulan junto con el precio
+    DiscountedMoments moments = discountedMoments(curve, cashflowTimes, cashflowAmounts);
+
+    BondRisk result;
+    result.price = moments.pv;
+    result.macaulayDuration = moments.first / moments.pv;
+    result.modifiedDuration = moments.first / moments.pv;
+    result.convexity = moments.second / moments.pv;
+    result.dv01 = moments.first * 1e-4;
+    return result;
+}
+
 #endif // BOND_HPP
\ No newline at end of file
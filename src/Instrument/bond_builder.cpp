@@ -1,9 +1,15 @@
 #include "bond_builder.hpp"
 
 std::unique_ptr<Instrument> BondBuilder::build(const InstrumentDescription& description) {
+    description.validate();
     return std::make_unique<Bond>(description);  
 }
 
+Bond BondBuilder::buildValue(const InstrumentDescription& description) {
+    description.validate();
+    return Bond(description);
+}
+
 InstrumentDescription::Type BondBuilder::getId() {
     return InstrumentDescription::bond;
-}
\ No newline at end of file
+}
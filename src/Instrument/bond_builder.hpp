@@ -6,7 +6,10 @@
 
 class BondBuilder {
 public:
+    using Product = Bond;  // Tipo concreto que construye (ver instrument_variant.hpp)
+
     static std::unique_ptr<Instrument> build(const InstrumentDescription& description);
+    static Bond buildValue(const InstrumentDescription& description);
     static InstrumentDescription::Type getId();
 };
 
@@ -0,0 +1,80 @@
+#ifndef CASHFLOW_HPP
+#define CASHFLOW_HPP
+
+#include <vector>
+#include <cstddef>
+#include "pricing_kernels.hpp"
+
+// Pata a la que pertenece un flujo
+enum class CashflowLeg { Fixed, Floating, Principal };
+
+// Datos descriptivos de un flujo (lo que no hace falta para descontar)
+struct CashflowInfo {
+    CashflowLeg leg;
+    double notional;      // Nominal con signo: amount = notional * rate * accrual (amount en principal)
+    double accrual;       // Fracción de devengo del periodo (0 en principal)
+    double rate;          // Tasa del periodo: cupón, fixing conocido o forward proyectado
+    double fixingStart;   // Periodo del índice en flotantes (igual a fixingEnd si no aplica)
+    double fixingEnd;
+    bool projected;       // true si el importe depende de la curva de proyección
+};
+
+/* Buffer reutilizable de flujos en columnas: tiempos e importes contiguos para
+ * que el descuento sea un único recorrido lineal, y la información de cada
+ * flujo aparte. clear() conserva la capacidad, de modo que un buffer de vida
+ * larga no vuelve a reservar memoria una vez alcanzado su tamaño de trabajo.
+ * Varios instrumentos pueden volcar en el mismo buffer; size() antes y después
+ * de cada uno delimita su rango.
+ */
+class CashflowBuffer {
+public:
+    void reserve(std::size_t n) {
+        times_.reserve(n);
+        amounts_.reserve(n);
+        info_.reserve(n);
+    }
+
+    void clear() {
+        times_.clear();
+        amounts_.clear();
+        info_.clear();
+    }
+
+    void add(double time, double amount, const CashflowInfo& info) {
+        times_.push_back(time);
+        amounts_.push_back(amount);
+        info_.push_back(info);
+    }
+
+    std::size_t size() const { return times_.size(); }
+    std::size_t capacity() const { return times_.capacity(); }
+    bool empty() const { return times_.empty(); }
+
+    double time(std::size_t i) const { return times_[i]; }
+    double amount(std::size_t i) const { return amounts_[i]; }
+    const CashflowInfo& info(std::size_t i) const { return info_[i]; }
+
+    const std::vector<double>& times() const { return times_; }
+    const std::vector<double>& amounts() const { return amounts_; }
+
+private:
+    std::vector<double> times_;
+    std::vector<double> amounts_;
+    std::vector<CashflowInfo> info_;
+};
+
+// PV de los flujos [first, last) del buffer contra cualquier curva
+template<typename Curve>
+inline double discountCashflows(const Curve& curve, const CashflowBuffer& buffer,
+                                std::size_t first, std::size_t last) {
+    return discountedSum(curve, buffer.times().data() + first,
+                         buffer.amounts().data() + first, last - first);
+}
+
+// PV de todo el buffer
+template<typename Curve>
+inline double discountCashflows(const Curve& curve, const CashflowBuffer& buffer) {
+    return discountCashflows(curve, buffer, 0, buffer.size());
+}
+
+#endif // CASHFLOW_HPP
@@ -0,0 +1,49 @@
+#include "cashflow_ladder.hpp"
+#include <algorithm>
+
+namespace {
+
+// Peso neto por debajo del cual una fecha se considera vacía (absorbe el
+// redondeo de pesos no enteros, p. ej. 0.1 + 0.2 - 0.3)
+const double kEmptyWeight = 1e-9;
+
+} // namespace
+
+void CashflowLadder::add(const Instrument& instrument, const ZeroCouponCurve& curve, double weight) {
+    if (weight == 0.0) return;
+    buffer_.clear();
+    instrument.cashflows(curve, buffer_);
+
+    // Cada fecha acumula el peso de las posiciones que le aportan; cuando se
+    // retiran todas se elimina, aunque el redondeo no deje los importes en 0.0
+    auto accumulate = [this, weight](double t, double fixed, double floating) {
+        Bucket& bucket = buckets_[t];
+        bucket.fixed += fixed;
+        bucket.floating += floating;
+        bucket.weight += weight;
+        if (bucket.weight <= kEmptyWeight) buckets_.erase(t);
+    };
+
+    for (std::size_t i = 0; i < buffer_.size(); ++i) {
+        const CashflowInfo& info = buffer_.info(i);
+        if (info.projected) {
+            // Periodo flotante telescopado: +N en el inicio, -N en el fin
+            accumulate(info.fixingStart, 0.0, weight * info.notional);
+            accumulate(info.fixingEnd, 0.0, -weight * info.notional);
+        } else {
+            accumulate(buffer_.time(i), weight * buffer_.amount(i), 0.0);
+        }
+    }
+
+    cashflows_ = std::max(0.0, cashflows_ + weight * static_cast<double>(buffer_.size()));
+}
+
+double CashflowLadder::fixedAmount(double t) const {
+    auto it = buckets_.find(t);
+    return it == buckets_.end() ? 0.0 : it->second.fixed;
+}
+
+double CashflowLadder::floatingWeight(double t) const {
+    auto it = buckets_.find(t);
+    return it == buckets_.end() ? 0.0 : it->second.floating;
+}
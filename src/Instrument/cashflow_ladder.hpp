@@ -0,0 +1,77 @@
+#ifndef CASHFLOW_LADDER_HPP
+#define CASHFLOW_LADDER_HPP
+
+#include "instrument.hpp"
+#include "cashflow.hpp"
+#include "zero_coupon_curve.hpp"
+#include <cmath>
+#include <map>
+#include <cstddef>
+
+// Valor de la escalera separado por tipo de flujo
+struct LadderValue {
+    double fixed = 0.0;      // Flujos que no dependen de la curva
+    double floating = 0.0;   // Flujos proyectados (forma telescopada)
+    double total() const { return fixed + floating; }
+};
+
+/* Escalera de flujos netos de una cartera, por fecha de pago.
+ *
+ * Los flujos fijos (cupones, principal, fixings ya conocidos) se suman por
+ * tiempo de pago. Los flotantes proyectados con la misma curva con la que se
+ * descuentan telescopan: notional * (DF(a) / DF(b) - 1) * DF(b) =
+ * notional * (DF(a) - DF(b)), así que cada periodo solo aporta dos pesos, +N en
+ * el inicio y -N en el fin, que también se netean por fecha. Revalorar toda la
+ * cartera con otra curva cuesta un DF por fecha distinta, en vez de uno por flujo.
+ *
+ * Es exacto frente a la valoración trade a trade monocurva (Bond::presentValue,
+ * Swap::npv). Los tiempos se toman tal cual de los instrumentos, así que las
+ * fechas solo se agrupan si los trades comparten fecha de referencia.
+ */
+class CashflowLadder {
+public:
+    // Añade (weight > 0) o retira (weight < 0) los flujos del instrumento,
+    // escalados por weight. Una fecha desaparece cuando el peso neto de las
+    // posiciones que le aportan vuelve a 0: add(x, 2.0) y luego remove(x) la
+    // mantiene con la mitad de la posición.
+    // La curva solo se usa para emitir los flujos; no queda referenciada.
+    void add(const Instrument& instrument, const ZeroCouponCurve& curve, double weight = 1.0);
+    void remove(const Instrument& instrument, const ZeroCouponCurve& curve) { add(instrument, curve, -1.0); }
+
+    void clear() {
+        buckets_.clear();
+        cashflows_ = 0;
+    }
+
+    std::size_t dates() const { return buckets_.size(); }
+    // Flujos añadidos y no retirados, ponderados por el peso de su posición
+    std::size_t cashflows() const { return static_cast<std::size_t>(std::llround(cashflows_)); }
+
+    // Importe fijo neto y peso flotante neto en el tiempo t (0 si no hay flujos)
+    double fixedAmount(double t) const;
+    double floatingWeight(double t) const;
+
+    template<typename Curve>
+    LadderValue value(const Curve& curve) const {
+        LadderValue result;
+        for (const auto& bucket : buckets_) {
+            double df = curve.getDiscountFactor(bucket.first);
+            result.fixed += bucket.second.fixed * df;
+            result.floating += bucket.second.floating * df;
+        }
+        return result;
+    }
+
+private:
+    struct Bucket {
+        double fixed = 0.0;
+        double floating = 0.0;
+        double weight = 0.0;   // Peso neto de los flujos (o extremos de periodo) que aportan
+    };
+
+    std::map<double, Bucket> buckets_;
+    double cashflows_ = 0.0;      // Σ weight * flujos emitidos
+    CashflowBuffer buffer_;       // Reutilizado entre llamadas a add()
+};
+
+#endif // CASHFLOW_LADDER_HPP
@@ -0,0 +1,111 @@
+#include "curve_handle.hpp"
+#include <stdexcept>
+#include <algorithm>
+
+namespace {
+
+// Registro global de índices de hilo lector. Cada hilo toma un índice la
+// primera vez que lee de un CurveHandle y lo devuelve al terminar.
+class ReaderRegistry {
+public:
+    static ReaderRegistry& instance() {
+        static ReaderRegistry registry;
+        return registry;
+    }
+
+    std::size_t acquire() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!free_.empty()) {
+            std::size_t index = free_.back();
+            free_.pop_back();
+            return index;
+        }
+        if (next_ == CurveHandle::kMaxReaderThreads)
+            throw std::runtime_error("Demasiados hilos lectores de curvas.");
+        return next_++;
+    }
+
+    void release(std::size_t index) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_.push_back(index);
+    }
+
+private:
+    std::mutex mutex_;
+    std::size_t next_ = 0;
+    std::vector<std::size_t> free_;
+};
+
+struct ThreadReaderIndex {
+    std::size_t index;
+    ThreadReaderIndex() : index(ReaderRegistry::instance().acquire()) {}
+    ~ThreadReaderIndex() { ReaderRegistry::instance().release(index); }
+};
+
+std::size_t currentReaderIndex() {
+    thread_local ThreadReaderIndex reader;
+    return reader.index;
+}
+
+} // namespace
+
+CurveHandle::CurveHandle(std::shared_ptr<ZeroCouponCurve> initial)
+    : current_(initial.get()), currentOwner_(std::move(initial)) {
+    if (!currentOwner_) throw std::invalid_argument("CurveHandle necesita una curva inicial.");
+    currentOwner_->published_.value = true;
+}
+
+// Se asume que ya no quedan lectores activos
+CurveHandle::~CurveHandle() = default;
+
+void CurveHandle::publish(std::shared_ptr<ZeroCouponCurve> curve) {
+    if (!curve) throw std::invalid_argument("No se puede publicar una curva nula.");
+    curve->published_.value = true;
+
+    std::lock_guard<std::mutex> lock(writerMutex_);
+    current_.store(curve.get());
+    std::uint64_t retireEpoch = epoch_.fetch_add(1) + 1;
+
+    retired_.push_back(Retired{std::move(currentOwner_), retireEpoch});
+    currentOwner_ = std::move(curve);
+    collectLocked();
+}
+
+void CurveHandle::collect() {
+    std::lock_guard<std::mutex> lock(writerMutex_);
+    collectLocked();
+}
+
+std::size_t CurveHandle::pendingReclamation() const {
+    std::lock_guard<std::mutex> lock(writerMutex_);
+    return retired_.size();
+}
+
+void CurveHandle::collectLocked() {
+    // Época más antigua anunciada por un lector activo
+    std::uint64_t oldest = kIdle;
+    for (const auto& slot : slots_) {
+        oldest = std::min(oldest, slot.epoch.load());
+    }
+
+    // Una curva retirada en la época r solo pudo verla un lector que entró antes de r
+    retired_.erase(std::remove_if(retired_.begin(), retired_.end(),
+                                  [oldest](const Retired& r) { return r.epoch <= oldest; }),
+                   retired_.end());
+}
+
+CurveHandle::ReadGuard::ReadGuard(const CurveHandle& handle)
+    : handle_(handle), slot_(currentReaderIndex()) {
+    ReaderSlot& slot = handle_.slots_[slot_];
+    if (slot.depth++ == 0) {
+        slot.epoch.store(handle_.epoch_.load());
+    }
+    curve_ = handle_.current_.load();
+}
+
+CurveHandle::ReadGuard::~ReadGuard() {
+    ReaderSlot& slot = handle_.slots_[slot_];
+    if (--slot.depth == 0) {
+        slot.epoch.store(kIdle);
+    }
+}
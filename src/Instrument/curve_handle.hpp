@@ -0,0 +1,87 @@
+#ifndef CURVE_HANDLE_HPP
+#define CURVE_HANDLE_HPP
+
+#include <atomic>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "zero_coupon_curve.hpp"
+
+// Punto de publicación de una curva compartida entre un hilo de calibración
+// (escritor) y muchos hilos de pricing (lectores).
+//
+// Los lectores son wait-free: anuncian la época actual en su propio slot
+// (una línea de caché por hilo) y leen el puntero publicado, sin tocar el
+// contador de referencias del shared_ptr ni ningún mutex. El escritor publica
+// la nueva curva con un intercambio atómico, avanza la época y retira la curva
+// anterior; ésta se libera en un publish()/collect() posterior, cuando ya no
+// queda ningún lector que haya podido verla.
+//
+// Las curvas publicadas pasan a ser de solo lectura: updateZeroRates() sobre
+// ellas lanza std::logic_error.
+class CurveHandle {
+public:
+    static constexpr std::size_t kMaxReaderThreads = 64;
+
+    explicit CurveHandle(std::shared_ptr<ZeroCouponCurve> initial);
+    ~CurveHandle();
+
+    CurveHandle(const CurveHandle&) = delete;
+    CurveHandle& operator=(const CurveHandle&) = delete;
+
+    // Escritor: publica una curva nueva. Las llamadas concurrentes se serializan.
+    void publish(std::shared_ptr<ZeroCouponCurve> curve);
+
+    // Escritor: libera las curvas retiradas que ya no pueden estar en uso.
+    void collect();
+
+    // Número de curvas retiradas pendientes de liberar
+    std::size_t pendingReclamation() const;
+
+    // Lector: mientras vive el guard, curve() devuelve siempre la misma curva.
+    // Se puede anidar dentro del mismo hilo.
+    class ReadGuard {
+    public:
+        explicit ReadGuard(const CurveHandle& handle);
+        ~ReadGuard();
+
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+        const ZeroCouponCurve& curve() const { return *curve_; }
+
+    private:
+        const CurveHandle& handle_;
+        std::size_t slot_;
+        const ZeroCouponCurve* curve_;
+    };
+
+private:
+    static constexpr std::uint64_t kIdle = UINT64_MAX;
+
+    // Un slot por hilo lector, alineado para que no compartan línea de caché
+    struct alignas(64) ReaderSlot {
+        std::atomic<std::uint64_t> epoch{kIdle};
+        std::size_t depth = 0;  // Solo lo toca el hilo dueño del slot
+    };
+
+    struct Retired {
+        std::shared_ptr<ZeroCouponCurve> curve;
+        std::uint64_t epoch;
+    };
+
+    void collectLocked();
+
+    alignas(64) std::atomic<const ZeroCouponCurve*> current_;
+    alignas(64) std::atomic<std::uint64_t> epoch_{1};
+    mutable std::array<ReaderSlot, kMaxReaderThreads> slots_;
+
+    mutable std::mutex writerMutex_;
+    std::shared_ptr<ZeroCouponCurve> currentOwner_;
+    std::vector<Retired> retired_;
+};
+
+#endif // CURVE_HANDLE_HPP
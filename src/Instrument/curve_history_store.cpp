@@ -0,0 +1,300 @@
+#include "curve_history_store.hpp"
+#include "fast_math.hpp"
+#include <fstream>
+#include <stdexcept>
+#include <cmath>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+const char kMagic[4] = {'Z', 'C', 'H', 'S'};
+const std::uint32_t kFormatVersion = 1;
+
+// Cabecera del fichero (32 bytes, alineada a 8)
+struct Header {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t rows;
+    std::uint32_t pillars;
+    std::uint32_t blockRows;
+    std::uint32_t reserved;
+    char currency[8];
+};
+
+const boost::gregorian::date kEpoch(1970, 1, 1);
+
+std::size_t alignTo8(std::size_t n) { return (n + 7) & ~static_cast<std::size_t>(7); }
+
+/* Codificación XOR por bytes
+ * x = valor ^ anterior. Se escribe un byte de cabecera (bytes a cero por arriba
+ * << 4 | bytes a cero por abajo) y solo los bytes intermedios. Si x == 0 basta
+ * con la cabecera 0x80. Valores cercanos comparten signo, exponente y los bits
+ * altos de la mantisa, así que ocupan bastante menos de 8 bytes.
+ */
+void encodeValue(std::vector<std::uint8_t>& out, std::uint64_t value, std::uint64_t& previous) {
+    std::uint64_t x = value ^ previous;
+    previous = value;
+    if (x == 0) {
+        out.push_back(0x80);
+        return;
+    }
+    int leading = __builtin_clzll(x) / 8;
+    int trailing = __builtin_ctzll(x) / 8;
+    out.push_back(static_cast<std::uint8_t>((leading << 4) | trailing));
+    for (int b = 7 - leading; b >= trailing; --b) {
+        out.push_back(static_cast<std::uint8_t>(x >> (8 * b)));
+    }
+}
+
+std::uint64_t doubleBits(double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+} // namespace
+
+std::uint64_t CurveHistoryStore::Decoder::next() {
+    std::uint8_t header = *cursor++;
+    if (header == 0x80) return previous;
+
+    int leading = header >> 4;
+    int trailing = header & 0x0F;
+    std::uint64_t x = 0;
+    for (int b = 7 - leading; b >= trailing; --b) {
+        x |= static_cast<std::uint64_t>(*cursor++) << (8 * b);
+    }
+    previous ^= x;
+    return previous;
+}
+
+void CurveHistoryStore::write(const std::string& path, const std::vector<HistoricalCurve>& curves) {
+    if (curves.empty()) throw std::invalid_argument("Histórico de curvas vacío.");
+
+    const std::size_t rows = curves.size();
+    const std::size_t pillars = curves.front().curve->getDates().size();
+    const std::size_t blocks = (rows + kBlockRows - 1) / kBlockRows;
+    const std::size_t streams = 2 * pillars;
+
+    for (std::size_t i = 0; i < rows; ++i) {
+        if (curves[i].curve->getDates().size() != pillars)
+            throw std::invalid_argument("Todas las curvas del histórico deben tener los mismos pilares.");
+        if (curves[i].currency != curves.front().currency)
+            throw std::invalid_argument("Todas las curvas del histórico deben ser de la misma divisa.");
+        if (i > 0 && curves[i].date <= curves[i - 1].date)
+            throw std::invalid_argument("El histórico debe estar ordenado por fecha sin repetir.");
+    }
+
+    // Comprimir cada columna por bloques que arrancan desde cero
+    std::vector<std::vector<std::uint8_t>> data(streams);
+    std::vector<std::uint64_t> offsets(streams * (blocks + 1));
+    for (std::size_t pillar = 0; pillar < pillars; ++pillar) {
+        for (int column = 0; column < 2; ++column) {
+            std::size_t stream = 2 * pillar + column;
+            std::vector<std::uint8_t>& out = data[stream];
+            std::uint64_t previous = 0;
+            for (std::size_t row = 0; row < rows; ++row) {
+                if (row % kBlockRows == 0) {
+                    offsets[stream * (blocks + 1) + row / kBlockRows] = out.size();
+                    previous = 0;
+                }
+                const ZeroCouponCurve& curve = *curves[row].curve;
+                std::uint64_t value = (column == 0)
+                    ? static_cast<std::uint64_t>(static_cast<std::int64_t>((curve.getDates()[pillar] - curves[row].date).days()))
+                    : doubleBits(curve.getZeroRates()[pillar]);
+                encodeValue(out, value, previous);
+            }
+            offsets[stream * (blocks + 1) + blocks] = out.size();
+        }
+    }
+
+    // Las columnas van una detrás de otra: desplazar los offsets a posición absoluta en la zona de datos
+    std::uint64_t streamStart = 0;
+    for (std::size_t stream = 0; stream < streams; ++stream) {
+        for (std::size_t b = 0; b <= blocks; ++b) offsets[stream * (blocks + 1) + b] += streamStart;
+        streamStart += data[stream].size();
+    }
+
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kFormatVersion;
+    header.rows = static_cast<std::uint32_t>(rows);
+    header.pillars = static_cast<std::uint32_t>(pillars);
+    header.blockRows = kBlockRows;
+    std::strncpy(header.currency, curves.front().currency.c_str(), sizeof(header.currency));
+
+    std::vector<std::int32_t> dates(rows);
+    for (std::size_t i = 0; i < rows; ++i) dates[i] = static_cast<std::int32_t>((curves[i].date - kEpoch).days());
+
+    std::ofstream output(path, std::ios::binary);
+    if (!output) throw std::runtime_error("No se pudo escribir el histórico: " + path);
+
+    const char padding[8] = {0};
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.write(reinterpret_cast<const char*>(dates.data()), rows * sizeof(std::int32_t));
+    output.write(padding, alignTo8(rows * sizeof(std::int32_t)) - rows * sizeof(std::int32_t));
+    output.write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(std::uint64_t));
+    for (const auto& column : data) {
+        output.write(reinterpret_cast<const char*>(column.data()), column.size());
+    }
+}
+
+CurveHistoryStore::CurveHistoryStore(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("No se pudo abrir el histórico: " + path);
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(Header)) {
+        ::close(fd);
+        throw std::runtime_error("Fichero de histórico inválido: " + path);
+    }
+    mappedSize_ = static_cast<std::size_t>(info.st_size);
+    mapped_ = ::mmap(nullptr, mappedSize_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapped_ == MAP_FAILED) {
+        mapped_ = nullptr;
+        throw std::runtime_error("No se pudo mapear el histórico: " + path);
+    }
+
+    const auto* bytes = static_cast<const std::uint8_t*>(mapped_);
+    Header header;
+    std::memcpy(&header, bytes, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kFormatVersion
+        || header.blockRows != kBlockRows) {
+        ::munmap(mapped_, mappedSize_);
+        mapped_ = nullptr;
+        throw std::runtime_error("Formato de histórico no soportado: " + path);
+    }
+
+    rows_ = header.rows;
+    pillars_ = header.pillars;
+    blocks_ = (rows_ + kBlockRows - 1) / kBlockRows;
+    currency_.assign(header.currency, strnlen(header.currency, sizeof(header.currency)));
+
+    // La cabecera determina el tamaño de fechas e índice (rows y pillars son de
+    // 32 bits, así que no desbordan); los offsets deben encadenar las columnas
+    // y acabar justo al final del fichero.
+    const std::size_t streams = 2 * pillars_;
+    std::size_t position = sizeof(Header);
+    std::size_t datesPosition = position;
+    position += alignTo8(rows_ * sizeof(std::int32_t));
+    std::size_t offsetsPosition = position;
+    position += streams * (blocks_ + 1) * sizeof(std::uint64_t);
+    if (position > mappedSize_) {
+        ::munmap(mapped_, mappedSize_);
+        mapped_ = nullptr;
+        throw std::runtime_error("Fichero de histórico truncado: " + path);
+    }
+
+    dates_ = reinterpret_cast<const std::int32_t*>(bytes + datesPosition);
+    blockOffsets_ = reinterpret_cast<const std::uint64_t*>(bytes + offsetsPosition);
+    base_ = bytes + position;
+
+    const std::uint64_t dataSize = mappedSize_ - position;
+    std::uint64_t expected = 0;
+    bool valid = true;
+    for (std::size_t stream = 0; stream < streams && valid; ++stream) {
+        const std::uint64_t* offsets = blockOffsets_ + stream * (blocks_ + 1);
+        valid = offsets[0] == expected;
+        for (std::size_t b = 0; b < blocks_ && valid; ++b) {
+            // Cada valor ocupa al menos un byte
+            std::size_t blockRows = std::min<std::size_t>(kBlockRows, rows_ - b * kBlockRows);
+            valid = offsets[b + 1] >= offsets[b] + blockRows && offsets[b + 1] <= dataSize;
+        }
+        expected = offsets[blocks_];
+    }
+    if (!valid || expected != dataSize) {
+        ::munmap(mapped_, mappedSize_);
+        mapped_ = nullptr;
+        throw std::runtime_error("Índice de bloques inválido en el histórico: " + path);
+    }
+}
+
+CurveHistoryStore::~CurveHistoryStore() {
+    if (mapped_) ::munmap(mapped_, mappedSize_);
+}
+
+boost::gregorian::date CurveHistoryStore::dateAt(std::size_t row) const {
+    return kEpoch + boost::gregorian::days(dates_[row]);
+}
+
+long CurveHistoryStore::find(const boost::gregorian::date& date) const {
+    std::int32_t key = static_cast<std::int32_t>((date - kEpoch).days());
+    const std::int32_t* it = std::lower_bound(dates_, dates_ + rows_, key);
+    if (it == dates_ + rows_ || *it != key) return -1;
+    return static_cast<long>(it - dates_);
+}
+
+std::size_t CurveHistoryStore::requireRow(const boost::gregorian::date& date) const {
+    long row = find(date);
+    if (row < 0)
+        throw std::invalid_argument("Fecha fuera del histórico: " + boost::gregorian::to_iso_extended_string(date));
+    return static_cast<std::size_t>(row);
+}
+
+CurveHistoryStore::Decoder CurveHistoryStore::decoderAt(std::size_t stream, std::size_t row) const {
+    std::size_t block = row / kBlockRows;
+    return Decoder{base_ + blockOffsets_[stream * (blocks_ + 1) + block], 0};
+}
+
+std::uint64_t CurveHistoryStore::valueAt(std::size_t stream, std::size_t row) const {
+    Decoder decoder = decoderAt(stream, row);
+    std::uint64_t value = 0;
+    for (std::size_t i = row - (row % kBlockRows); i <= row; ++i) value = decoder.next();
+    return value;
+}
+
+double CurveHistoryStore::discountFactor(const boost::gregorian::date& date, double t) const {
+    std::size_t row = requireRow(date);
+
+    // Mismo convenio que interpolateDiscount (discount_curve.hpp), sin materializar
+    // la curva: los pilares están ordenados, así que se buscan los dos que rodean
+    // a t decodificando solo los plazos que visita la búsqueda binaria
+    auto maturity = [&](std::size_t p) {
+        return static_cast<std::int64_t>(valueAt(dayStream(p), row)) / 360.0;
+    };
+    auto pillarDiscount = [&](std::size_t p, double m) {
+        std::uint64_t bits = valueAt(rateStream(p), row);
+        double rate;
+        std::memcpy(&rate, &bits, sizeof(rate));
+        return fastmath::exp(-rate / 100.0 * m);
+    };
+
+    double x0 = maturity(0);
+    if (t < x0) return 1.0 + (pillarDiscount(0, x0) - 1.0) * t / x0;
+    if (t == x0) return pillarDiscount(0, x0);
+    double x1 = maturity(pillars_ - 1);
+    if (t >= x1) return pillarDiscount(pillars_ - 1, x1);
+
+    // Invariante: plazo(lo) < t <= plazo(hi)
+    std::size_t lo = 0, hi = pillars_ - 1;
+    while (hi - lo > 1) {
+        std::size_t mid = lo + (hi - lo) / 2;
+        double m = maturity(mid);
+        if (m < t) {
+            lo = mid;
+            x0 = m;
+        } else {
+            hi = mid;
+            x1 = m;
+        }
+    }
+    double y0 = pillarDiscount(lo, x0), y1 = pillarDiscount(hi, x1);
+    return y0 + (t - x0) * (y1 - y0) / (x1 - x0);
+}
+
+std::shared_ptr<ZeroCouponCurve> CurveHistoryStore::curveAt(const boost::gregorian::date& date) const {
+    std::size_t row = requireRow(date);
+
+    std::vector<double> zeroRates(pillars_);
+    std::vector<boost::gregorian::date> pillarDates(pillars_);
+    for (std::size_t p = 0; p < pillars_; ++p) {
+        pillarDates[p] = date + boost::gregorian::days(static_cast<std::int64_t>(valueAt(dayStream(p), row)));
+        std::uint64_t bits = valueAt(rateStream(p), row);
+        std::memcpy(&zeroRates[p], &bits, sizeof(double));
+    }
+    return std::make_shared<ZeroCouponCurve>(date, zeroRates, pillarDates);
+}
@@ -0,0 +1,106 @@
+#ifndef CURVE_HISTORY_STORE_HPP
+#define CURVE_HISTORY_STORE_HPP
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <boost/date_time/gregorian/gregorian.hpp>
+#include "historical_curve_builder.hpp"
+#include "zero_coupon_curve.hpp"
+
+/*
+ * Almacén columnar de histórico de curvas
+ * =======================================
+ * Guarda en disco el histórico de una divisa (todas las curvas con el mismo
+ * número de pilares) en columnas por pilar:
+ *   - índice de fechas sin comprimir (días desde 1970-01-01), para búsqueda binaria
+ *   - por cada pilar, una columna con los días hasta la fecha del pilar y otra
+ *     con la tasa cero (%), comprimidas con XOR respecto al valor anterior.
+ * Las columnas se parten en bloques de kBlockRows filas que empiezan de cero,
+ * así una consulta puntual solo descomprime un bloque por columna.
+ *
+ * El fichero se lee con mmap. Las curvas reconstruidas son idénticas (bit a bit)
+ * a las calibradas, porque se guardan exactamente las fechas y tasas de entrada.
+ */
+class CurveHistoryStore {
+public:
+    static constexpr std::uint32_t kBlockRows = 64;
+
+    // Escribe el histórico (una sola divisa, ordenado por fecha, sin fechas repetidas)
+    static void write(const std::string& path, const std::vector<HistoricalCurve>& curves);
+
+    explicit CurveHistoryStore(const std::string& path);
+    ~CurveHistoryStore();
+
+    CurveHistoryStore(const CurveHistoryStore&) = delete;
+    CurveHistoryStore& operator=(const CurveHistoryStore&) = delete;
+
+    std::size_t size() const { return rows_; }
+    std::size_t pillars() const { return pillars_; }
+    const std::string& currency() const { return currency_; }
+    std::size_t fileSize() const { return mappedSize_; }
+
+    boost::gregorian::date dateAt(std::size_t row) const;
+
+    // Fila de la fecha, o -1 si no está en el histórico
+    long find(const boost::gregorian::date& date) const;
+
+    // DF(fecha, t) con la misma interpolación que ZeroCouponCurve; solo decodifica
+    // los pilares que rodean a t y no reserva memoria
+    double discountFactor(const boost::gregorian::date& date, double t) const;
+
+    // Curva completa de una fecha
+    std::shared_ptr<ZeroCouponCurve> curveAt(const boost::gregorian::date& date) const;
+
+    // Recorrido secuencial de un pilar: visit(fecha, fraccion_anio, tasa_cero)
+    template<typename Visitor>
+    void scanPillar(std::size_t pillar, Visitor&& visit) const;
+
+private:
+    struct Decoder {
+        const std::uint8_t* cursor;
+        std::uint64_t previous;
+        std::uint64_t next();
+    };
+
+    Decoder decoderAt(std::size_t stream, std::size_t row) const;
+    std::uint64_t valueAt(std::size_t stream, std::size_t row) const;
+    std::size_t requireRow(const boost::gregorian::date& date) const;
+
+    static std::size_t dayStream(std::size_t pillar) { return 2 * pillar; }
+    static std::size_t rateStream(std::size_t pillar) { return 2 * pillar + 1; }
+
+    void* mapped_ = nullptr;
+    std::size_t mappedSize_ = 0;
+    std::size_t rows_ = 0;
+    std::size_t pillars_ = 0;
+    std::size_t blocks_ = 0;
+    std::string currency_;
+    const std::int32_t* dates_ = nullptr;
+    const std::uint64_t* blockOffsets_ = nullptr;   // [stream][block + 1]
+    const std::uint8_t* base_ = nullptr;
+};
+
+template<typename Visitor>
+void CurveHistoryStore::scanPillar(std::size_t pillar, Visitor&& visit) const {
+    const boost::gregorian::date epoch(1970, 1, 1);
+    for (std::size_t block = 0; block < blocks_; ++block) {
+        std::size_t first = block * kBlockRows;
+        Decoder days = decoderAt(dayStream(pillar), first);
+        Decoder rates = decoderAt(rateStream(pillar), first);
+        std::size_t last = std::min<std::size_t>(first + kBlockRows, rows_);
+        for (std::size_t row = first; row < last; ++row) {
+            std::int64_t pillarDays = static_cast<std::int64_t>(days.next());
+            std::uint64_t rateBits = rates.next();
+            double rate;
+            std::memcpy(&rate, &rateBits, sizeof(rate));
+            visit(epoch + boost::gregorian::days(dates_[row]), pillarDays / 360.0, rate);
+        }
+    }
+}
+
+#endif // CURVE_HISTORY_STORE_HPP
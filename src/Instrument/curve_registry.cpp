@@ -0,0 +1,55 @@
+#include "curve_registry.hpp"
+#include <stdexcept>
+
+CurveRegistry::~CurveRegistry() {
+    for (auto& block : blocks_) delete[] block.load(std::memory_order_relaxed);
+}
+
+CurveRegistry::CurveId CurveRegistry::intern(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = ids_.find(name);
+    if (it != ids_.end()) return it->second;
+
+    std::size_t id = size_.load(std::memory_order_relaxed);
+    if (id >= kMaxCurves) throw std::length_error("Demasiadas curvas registradas: " + name);
+
+    // Los bloques ya publicados no se tocan: los lectores pueden estar leyéndolos
+    Entry* block = blocks_[id / kBlockSize].load(std::memory_order_relaxed);
+    if (!block) {
+        block = new Entry[kBlockSize];
+        blocks_[id / kBlockSize].store(block, std::memory_order_release);
+    }
+    block[id % kBlockSize].name = name;
+    ids_.emplace(name, static_cast<CurveId>(id));
+    size_.store(id + 1, std::memory_order_release);
+    return static_cast<CurveId>(id);
+}
+
+CurveRegistry::CurveId CurveRegistry::find(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = ids_.find(name);
+    if (it == ids_.end()) throw std::invalid_argument("Curva no registrada: " + name);
+    return it->second;
+}
+
+void CurveRegistry::publish(CurveId id, std::shared_ptr<ZeroCouponCurve> curve) {
+    Entry& e = entry(id);
+    CurveHandle* handle;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!e.owner) {
+            e.owner = std::make_unique<CurveHandle>(std::move(curve));
+            e.handle.store(e.owner.get(), std::memory_order_release);
+            return;
+        }
+        handle = e.owner.get();
+    }
+    // CurveHandle serializa sus propios escritores
+    handle->publish(std::move(curve));
+}
+
+CurveRegistry::CurveId CurveRegistry::publish(const std::string& name, std::shared_ptr<ZeroCouponCurve> curve) {
+    CurveId id = intern(name);
+    publish(id, std::move(curve));
+    return id;
+}
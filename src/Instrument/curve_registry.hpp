@@ -0,0 +1,78 @@
+#ifndef CURVE_REGISTRY_HPP
+#define CURVE_REGISTRY_HPP
+
+#include <unordered_map>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+#include "curve_handle.hpp"
+
+// Registro de curvas por nombre ("EUR-ESTR", "Euribor6M", ...).
+// Cada nombre se interna una sola vez y se referencia con un CurveId pequeño,
+// así el pricing accede a la curva por índice sin comparar strings ni copiar
+// shared_ptr. Cada curva se publica a través de un CurveHandle, de modo que se
+// puede republicar mientras otros hilos valoran.
+//
+// intern(), find() y publish() se pueden llamar mientras otros hilos valoran:
+// las entradas viven en bloques de tamaño fijo que nunca se mueven, y el número
+// de entradas y el handle de cada una se publican de forma atómica, así que
+// handle() lee sin bloquear. Las altas se serializan con un mutex.
+class CurveRegistry {
+public:
+    using CurveId = std::uint32_t;
+
+    static constexpr std::size_t kBlockSize = 64;
+    static constexpr std::size_t kMaxBlocks = 1024;
+    static constexpr std::size_t kMaxCurves = kBlockSize * kMaxBlocks;
+
+    CurveRegistry() = default;
+    ~CurveRegistry();
+
+    CurveRegistry(const CurveRegistry&) = delete;
+    CurveRegistry& operator=(const CurveRegistry&) = delete;
+
+    // Devuelve el id del nombre, creándolo si no existía (lanza si se supera kMaxCurves)
+    CurveId intern(const std::string& name);
+
+    // Devuelve el id de un nombre ya registrado (lanza si no existe)
+    CurveId find(const std::string& name) const;
+
+    const std::string& name(CurveId id) const { return entry(id).name; }
+    std::size_t size() const { return size_.load(std::memory_order_acquire); }
+
+    // Publica (o republica) la curva asociada al id
+    void publish(CurveId id, std::shared_ptr<ZeroCouponCurve> curve);
+    CurveId publish(const std::string& name, std::shared_ptr<ZeroCouponCurve> curve);
+
+    // Acceso O(1) para el pricing. Lanza si el id todavía no tiene curva.
+    CurveHandle& handle(CurveId id) const {
+        const Entry& e = entry(id);
+        CurveHandle* h = e.handle.load(std::memory_order_acquire);
+        if (!h) throw std::runtime_error("Curva sin publicar: " + e.name);
+        return *h;
+    }
+
+private:
+    struct Entry {
+        std::string name;
+        std::unique_ptr<CurveHandle> owner;       // Sólo se modifica con mutex_
+        std::atomic<CurveHandle*> handle{nullptr};
+    };
+
+    Entry& entry(CurveId id) const {
+        if (id >= size()) throw std::out_of_range("Id de curva inválido: " + std::to_string(id));
+        return blocks_[id / kBlockSize].load(std::memory_order_acquire)[id % kBlockSize];
+    }
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, CurveId> ids_;
+    std::array<std::atomic<Entry*>, kMaxBlocks> blocks_{};
+    std::atomic<std::size_t> size_{0};
+};
+
+#endif // CURVE_REGISTRY_HPP
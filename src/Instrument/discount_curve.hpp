@@ -0,0 +1,137 @@
+#ifndef DISCOUNT_CURVE_HPP
+#define DISCOUNT_CURVE_HPP
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <cstddef>
+#include "fast_math.hpp"
+
+/*
+ * Concepto de curva de descuento
+ * ==============================
+ * Cualquier tipo con un método
+ *
+ *     double getDiscountFactor(double t) const;
+ *
+ * sirve como curva para los kernels de pricing (pricing_kernels.hpp, Bond::risk,
+ * Swap::valuation, ...). Los kernels son plantillas sobre la curva, así que el
+ * compilador puede expandir el lookup dentro del bucle de flujos.
+ *
+ * Implementaciones: ZeroCouponCurve y YieldCurve (pilares interpolados),
+ * FlatCurve, SpreadCurve<Base> y NelsonSiegelSvenssonCurve.
+ * Las tasas de las curvas de este fichero van en decimal y en capitalización continua.
+ */
+
+// Interpolación lineal con extrapolación plana en los extremos
+inline double interpolateLinear(const std::vector<double>& x, const std::vector<double>& y, double t) {
+    if (t <= x.front()) return y.front();
+    if (t >= x.back()) return y.back();
+
+    std::size_t index = std::lower_bound(x.begin(), x.end(), t) - x.begin();
+
+    double x0 = x[index - 1], x1 = x[index];
+    double y0 = y[index - 1], y1 = y[index];
+    return y0 + (t - x0) * (y1 - y0) / (x1 - x0);
+}
+
+// Factores de descuento interpolados entre pilares. Antes del primer pilar se
+// interpola desde DF(0) = 1: la extrapolación plana daría DF(t) = DF(t_1) y un
+// DF forward incoherente dentro de [0, t_1). Tras el último pilar, plano.
+// Es el convenio de todas las curvas de pilares (ZeroCouponCurve, YieldCurve).
+inline double interpolateDiscount(const std::vector<double>& x, const std::vector<double>& y, double t) {
+    if (t < x.front()) return 1.0 + (y.front() - 1.0) * t / x.front();
+    return interpolateLinear(x, y, t);
+}
+
+// Curva plana: DF(t) = exp(-r t)
+class FlatCurve {
+public:
+    explicit FlatCurve(double rate) : rate_(rate) {}
+
+    double getDiscountFactor(double t) const { return fastmath::exp(-rate_ * t); }
+    double rate() const { return rate_; }
+
+private:
+    double rate_;
+};
+
+// Curva base desplazada por un spread continuo: DF(t) = DF_base(t) * exp(-s t).
+// Con spread constante es también el desplazamiento paralelo usado en el riesgo.
+// Guarda una referencia a la curva base: no se puede construir sobre un temporal.
+template<typename BaseCurve>
+class SpreadCurve {
+public:
+    SpreadCurve(const BaseCurve& base, double spread) : base_(base), spread_(spread) {}
+    SpreadCurve(const BaseCurve&& base, double spread) = delete;
+
+    double getDiscountFactor(double t) const {
+        return base_.getDiscountFactor(t) * fastmath::exp(-spread_ * t);
+    }
+    double spread() const { return spread_; }
+
+private:
+    const BaseCurve& base_;
+    double spread_;
+};
+
+template<typename BaseCurve>
+SpreadCurve<BaseCurve> makeSpreadCurve(const BaseCurve& base, double spread) {
+    return SpreadCurve<BaseCurve>(base, spread);
+}
+
+template<typename BaseCurve>
+void makeSpreadCurve(const BaseCurve&& base, double spread) = delete;
+
+// Curva paramétrica Nelson-Siegel-Svensson:
+// z(t) = b0 + b1 * L1(t) + b2 * (L1(t) - e^{-t/tau1}) + b3 * (L2(t) - e^{-t/tau2}),
+// con Lk(t) = (1 - e^{-t/tauk}) / (t/tauk)
+class NelsonSiegelSvenssonCurve {
+public:
+    NelsonSiegelSvenssonCurve(double beta0, double beta1, double beta2, double beta3,
+                              double tau1, double tau2)
+        : beta0_(beta0), beta1_(beta1), beta2_(beta2), beta3_(beta3), tau1_(tau1), tau2_(tau2) {}
+
+    double zeroRate(double t) const {
+        if (t <= 0.0) return beta0_ + beta1_;
+        double x1 = t / tau1_, x2 = t / tau2_;
+        double e1 = fastmath::exp(-x1), e2 = fastmath::exp(-x2);
+        double l1 = (1.0 - e1) / x1, l2 = (1.0 - e2) / x2;
+        return beta0_ + beta1_ * l1 + beta2_ * (l1 - e1) + beta3_ * (l2 - e2);
+    }
+
+    double getDiscountFactor(double t) const { return fastmath::exp(-zeroRate(t) * t); }
+
+    // ∂z(t)/∂(b0, b1, b2, b3, tau1, tau2)
+    void zeroRateGradient(double t, double gradient[6]) const {
+        if (t <= 0.0) {
+            gradient[0] = gradient[1] = 1.0;
+            gradient[2] = gradient[3] = gradient[4] = gradient[5] = 0.0;
+            return;
+        }
+        double x1 = t / tau1_, x2 = t / tau2_;
+        double e1 = fastmath::exp(-x1), e2 = fastmath::exp(-x2);
+        double l1 = (1.0 - e1) / x1, l2 = (1.0 - e2) / x2;
+        // dLk/dtauk = (Lk - e_k) / tauk y de_k/dtauk = e_k * x_k / tauk
+        double dl1 = (l1 - e1) / tau1_, dl2 = (l2 - e2) / tau2_;
+        gradient[0] = 1.0;
+        gradient[1] = l1;
+        gradient[2] = l1 - e1;
+        gradient[3] = l2 - e2;
+        gradient[4] = beta1_ * dl1 + beta2_ * (dl1 - e1 * x1 / tau1_);
+        gradient[5] = beta3_ * (dl2 - e2 * x2 / tau2_);
+    }
+
+    double beta0() const { return beta0_; }
+    double beta1() const { return beta1_; }
+    double beta2() const { return beta2_; }
+    double beta3() const { return beta3_; }
+    double tau1() const { return tau1_; }
+    double tau2() const { return tau2_; }
+
+private:
+    double beta0_, beta1_, beta2_, beta3_;
+    double tau1_, tau2_;
+};
+
+#endif // DISCOUNT_CURVE_HPP
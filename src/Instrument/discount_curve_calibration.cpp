@@ -1,4 +1,7 @@
 #include "discount_curve_calibration.hpp"
+#include "curve_handle.hpp"
+#include "schedule_table.hpp"
+#include "fast_math.hpp"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
@@ -9,7 +12,8 @@ CurveCalibrator::CurveCalibrator(const boost::gregorian::date &baseDate,
                                  InterpolationMethod method)
     : baseDate_(baseDate),
       dayCalculator_(std::make_unique<Actual_360>()),
-      interpolationMethod_(method) {}
+      interpolationMethod_(method),
+      verbose_(true) {}
 
 // Tomamos los depósitos como bonos cupón cero
 void CurveCalibrator::addDeposit(double rate, int months)
@@ -34,13 +38,13 @@ void CurveCalibrator::addDeposit(double rate, int months)
     instrumentRates_[instruments_.size()] = rate / 100.0;
     maturitiesInMonths_[instruments_.size()] = months;
 
-    // Crear el instrumento usando la factoría
-    auto instrument = Factory::instance()(desc);
-    instruments_.push_back(std::move(instrument));
+    // Instrumento por valor: el tipo queda en el variant, sin RTTI
+    instruments_.push_back(makeInstrument(desc));
 
-    std::cout << "Depósito agregado: " << months << "m, rate = " << rate << "%, "
-              << "vencimiento = " << boost::gregorian::to_iso_extended_string(maturityDate)
-              << std::endl;
+    if (verbose_)
+        std::cout << "Depósito agregado: " << months << "m, rate = " << rate << "%, "
+                  << "vencimiento = " << boost::gregorian::to_iso_extended_string(maturityDate)
+                  << std::endl;
 }
 
 // Método para agregar un swap
@@ -70,18 +74,24 @@ void CurveCalibrator::addSwap(double rate, int months, int fixedFrequency, int f
     instrumentRates_[instruments_.size()] = rate / 100.0;
     maturitiesInMonths_[instruments_.size()] = months;
 
-    // Crear el instrumento usando la factoría
-    auto instrument = Factory::instance()(desc);
-    instruments_.push_back(std::move(instrument));
+    // Instrumento por valor: el tipo queda en el variant, sin RTTI
+    instruments_.push_back(makeInstrument(desc));
 
-    std::cout << "Swap agregado: " << months << "m, rate = " << rate << "%, "
-              << "vencimiento = " << boost::gregorian::to_iso_extended_string(maturityDate)
-              << std::endl;
+    if (verbose_)
+        std::cout << "Swap agregado: " << months << "m, rate = " << rate << "%, "
+                  << "vencimiento = " << boost::gregorian::to_iso_extended_string(maturityDate)
+                  << std::endl;
 }
 
 std::shared_ptr<ZeroCouponCurve> CurveCalibrator::calibrate()
 {
-    std::cout << "\nIniciando calibración de curva..." << std::endl;
+    if (verbose_)
+        std::cout << "\nIniciando calibración de curva..." << std::endl;
+
+    if (instruments_.empty())
+    {
+        throw std::runtime_error("No hay instrumentos para calibrar la curva");
+    }
 
     // Ordenar los instrumentos por vencimiento
     std::vector<size_t> indices(instruments_.size());
@@ -97,7 +107,7 @@ std::shared_ptr<ZeroCouponCurve> CurveCalibrator::calibrate()
               });
 
     // Crear vectores temporales para instrumentos ordenados
-    std::vector<std::unique_ptr<Instrument>> sortedInstruments;
+    std::vector<InstrumentVariant> sortedInstruments;
     std::map<size_t, double> sortedRates;
     std::map<size_t, int> sortedMaturities;
 
@@ -115,26 +125,148 @@ std::shared_ptr<ZeroCouponCurve> CurveCalibrator::calibrate()
     instrumentRates_ = std::move(sortedRates);
     maturitiesInMonths_ = std::move(sortedMaturities);
 
-    // Vectores para almacenar resultados
-    std::vector<double> zeroRates;
-    std::vector<double> maturitiesInYears;
-    std::vector<boost::gregorian::date> maturities;
-    std::vector<double> discountFactors;
+    buildBootstrapPlan();
+    bootstrap();
+
+    // Crear y retornar la curva calibrada
+    return std::make_shared<ZeroCouponCurve>(baseDate_, zeroRates_, maturityDates_);
+}
+
+void CurveCalibrator::recalibrate(const std::vector<double> &rates, ZeroCouponCurve &curve)
+{
+    if (!steps_.empty() && curve.getMaturities().size() != steps_.size())
+    {
+        throw std::invalid_argument("Se necesita una cotización por pilar de la última calibración");
+    }
+    // Antes del bootstrap, para no dejar los jacobianos desalineados con la curva
+    if (curve.published())
+    {
+        throw std::logic_error("La curva está publicada en un CurveHandle: hay que recalibrar sobre el handle");
+    }
+    bootstrapQuotes(rates);
+    curve.updateZeroRates(zeroRates_);
+}
+
+void CurveCalibrator::recalibrate(const std::vector<double> &rates, CurveHandle &handle)
+{
+    bootstrapQuotes(rates);
+    handle.publish(std::make_shared<ZeroCouponCurve>(baseDate_, zeroRates_, maturityDates_));
+}
+
+// Bootstrap con nuevas cotizaciones sobre el plan de la última calibrate()
+void CurveCalibrator::bootstrapQuotes(const std::vector<double> &rates)
+{
+    if (steps_.empty())
+    {
+        throw std::runtime_error("recalibrate() necesita una calibración previa");
+    }
+    if (rates.size() != steps_.size())
+    {
+        throw std::invalid_argument("Se necesita una cotización por pilar de la última calibración");
+    }
+
+    for (size_t i = 0; i < rates.size(); ++i)
+    {
+        instrumentRates_[i] = rates[i] / 100.0;
+    }
+    bootstrap();
+}
+
+// Calendario de cada pilar: vencimiento y periodos intermedios de los swaps.
+// No depende de las cotizaciones, así que se calcula una vez por calibrate().
+void CurveCalibrator::buildBootstrapPlan()
+{
+    const size_t quotes = instruments_.size();
+    steps_.assign(quotes, BootstrapStep());
+    periodTimes_.clear();
+    periodAccruals_.clear();
+    maturityDates_.clear();
+
+    for (size_t i = 0; i < quotes; ++i)
+    {
+        BootstrapStep &step = steps_[i];
+        step.months = maturitiesInMonths_[i];
+
+        boost::gregorian::date maturityDate = baseDate_ + boost::gregorian::months(step.months);
+        step.yearFraction = dayCalculator_->compute_daycount(baseDate_, maturityDate) / 360.0;
+        maturityDates_.push_back(maturityDate);
+
+        // Verificar el tipo de instrumento
+        if (std::holds_alternative<Bond>(instruments_[i]))
+        {
+            step.deposit = true;
+        }
+        else if (const Swap *swap = std::get_if<Swap>(&instruments_[i]))
+        {
+            // Construir las fechas de pago intermedias
+            std::vector<boost::gregorian::date> paymentDates =
+                buildPaymentDates(baseDate_, step.months, static_cast<int>(swap->getFixedFrequency()));
+
+            step.firstPeriod = periodTimes_.size();
+            boost::gregorian::date previousDate = baseDate_;
+            for (size_t j = 1; j < paymentDates.size() - 1; j++)
+            {
+                periodAccruals_.push_back(dayCalculator_->compute_daycount(previousDate, paymentDates[j]) / 360.0);
+                periodTimes_.push_back(dayCalculator_->compute_daycount(baseDate_, paymentDates[j]) / 360.0);
+                previousDate = paymentDates[j];
+            }
+            step.lastPeriod = periodTimes_.size();
+
+            // Calcular el accrual del último período
+            step.finalAccrual = dayCalculator_->compute_daycount(
+                paymentDates[paymentDates.size() - 2],
+                paymentDates[paymentDates.size() - 1]
+            ) / 360.0;
+        }
+        else
+        {
+            throw std::runtime_error("Tipo de instrumento no soportado en la calibración");
+        }
+    }
+
+    // El bootstrap rellena estos vectores con push_back: con la capacidad
+    // reservada aquí las recalibraciones no vuelven a reservar memoria
+    zeroRates_.reserve(quotes);
+    maturitiesInYears_.reserve(quotes);
+    discountFactors_.reserve(quotes);
+    sumGradient_.assign(quotes, 0.0);
+}
+
+namespace
+{
+// Deja la matriz n x n a cero reutilizando las filas existentes
+void resetMatrix(std::vector<std::vector<double>> &matrix, size_t n)
+{
+    matrix.resize(n);
+    for (auto &row : matrix)
+    {
+        row.assign(n, 0.0);
+    }
+}
+}
+
+void CurveCalibrator::bootstrap()
+{
+    zeroRates_.clear();
+    maturitiesInYears_.clear();
+    discountFactors_.clear();
+
+    // Gradiente de cada DF respecto a las cotizaciones (en %), en modo directo:
+    // cada pilar solo depende de su cotización y de los pilares anteriores
+    const size_t quotes = steps_.size();
+    resetMatrix(discountFactorJacobian_, quotes);
+    resetMatrix(zeroRateJacobian_, quotes);
 
     // Calibrar para cada instrumento
-    for (size_t i = 0; i < instruments_.size(); ++i)
+    for (size_t i = 0; i < quotes; ++i)
     {
-        auto &instrument = instruments_[i];
-        int months = maturitiesInMonths_[i];
+        const BootstrapStep &step = steps_[i];
         double rate = instrumentRates_[i];
-
-        boost::gregorian::date maturityDate = baseDate_ + boost::gregorian::months(months);
-        double yearFraction = dayCalculator_->compute_daycount(baseDate_, maturityDate) / 360.0;
+        double yearFraction = step.yearFraction;
 
         double df = 0.0;
 
-        // Verificar el tipo de instrumento
-        if (Bond *bond = dynamic_cast<Bond *>(instrument.get()))
+        if (step.deposit)
         {
             /* Es un depósito (bono cupón cero)
              *
@@ -147,92 +279,94 @@ std::shared_ptr<ZeroCouponCurve> CurveCalibrator::calibrate()
              */
             df = 1.0 / (1.0 + rate * yearFraction);
 
-            std::cout << "Calibrado depósito " << months << "m: DF = "
-                      << std::fixed << std::setprecision(6) << df;
+            // ∂DF/∂r = -T * DF²
+            discountFactorJacobian_[i][i] = -yearFraction * df * df / 100.0;
+
+            if (verbose_)
+                std::cout << "Calibrado depósito " << step.months << "m: DF = "
+                          << std::fixed << std::setprecision(6) << df;
         }
-        else if (Swap *swap = dynamic_cast<Swap *>(instrument.get()))
+        else
         {
-            // Calcular la fecha de vencimiento del swap
-            boost::gregorian::date maturityDate = baseDate_ + boost::gregorian::months(months);
-            
-            // Obtener la frecuencia de pagos fijos del swap
-            double frequency = swap->getFixedFrequency();
-            
-            // Construir las fechas de pago intermedias
-            std::vector<boost::gregorian::date> paymentDates = buildPaymentDates(baseDate_, maturityDate, frequency);
-            
             // Suma para el cálculo del factor de descuento
             double sumPreviousDiscountFactors = 0.0;
-            
+            // ∂S/∂q a través de los pilares anteriores usados en la interpolación
+            std::fill(sumGradient_.begin(), sumGradient_.end(), 0.0);
+
             // Calcular la suma de DF(t_i) * accrual_i de todos los instrumentos anteriores
-            boost::gregorian::date previousDate = baseDate_;
-            
-            for (size_t j = 1; j < paymentDates.size()-1; j++) {
-                double periodYearFraction = dayCalculator_->compute_daycount(previousDate, paymentDates[j]) / 360.0;
+            for (size_t j = step.firstPeriod; j < step.lastPeriod; j++) {
+                double periodYearFraction = periodAccruals_[j];
 
                 // Interpolamos el factor de descuento si no coincide exactamente con uno ya calculado
+                InterpolationSensitivity sensitivity;
                 double periodDiscountFactor = interpolateDiscountFactor(
-                    dayCalculator_->compute_daycount(baseDate_, paymentDates[j]) / 360.0,
-                    maturitiesInYears,
-                    discountFactors
+                    periodTimes_[j],
+                    maturitiesInYears_,
+                    discountFactors_,
+                    &sensitivity
                 );
-                
+                for (size_t k = 0; k < i; ++k) {
+                    sumGradient_[k] += periodYearFraction *
+                        (sensitivity.dLower * discountFactorJacobian_[sensitivity.lower][k] +
+                         sensitivity.dUpper * discountFactorJacobian_[sensitivity.upper][k]);
+                }
+
                 // Acumulamos el producto del factor de descuento por el periodo de accrual
                 sumPreviousDiscountFactors += periodDiscountFactor * periodYearFraction;
-                previousDate = paymentDates[j];
             }
-            
-            // Calcular el accrual del último período
-            double finalAccrual = dayCalculator_->compute_daycount(
-                paymentDates[paymentDates.size() - 2], 
-                paymentDates[paymentDates.size() - 1]
-            ) / 360.0;
-            
+
+            double finalAccrual = step.finalAccrual;
+
             // Calcular el factor de descuento usando la fórmula:
             // DF(T) = (1 - S * Σ(DF(t_i) * accrual_i)) / (1 + S * Δt_final)
             df = (1.0 - rate * sumPreviousDiscountFactors) / (1.0 + rate * finalAccrual);
-            
-            std::cout << "Calibrado swap " << months << "m: DF = "
-                      << std::fixed << std::setprecision(6) << df;
-        }
-        else
-        {
-            throw std::runtime_error("Tipo de instrumento no soportado en la calibración");
+
+            // ∂DF/∂r = -(S + a * DF) / (1 + r a) y ∂DF/∂S = -r / (1 + r a)
+            double denominator = 1.0 + rate * finalAccrual;
+            for (size_t k = 0; k < i; ++k) {
+                discountFactorJacobian_[i][k] = -rate * sumGradient_[k] / denominator;
+            }
+            discountFactorJacobian_[i][i] =
+                -(sumPreviousDiscountFactors + finalAccrual * df) / denominator / 100.0;
+
+            if (verbose_)
+                std::cout << "Calibrado swap " << step.months << "m: DF = "
+                          << std::fixed << std::setprecision(6) << df;
         }
 
-        discountFactors.push_back(df);
+        discountFactors_.push_back(df);
 
         // Calcular tasa zero-coupon equivalente
         // Fórmula: r = -ln(DF(T)) / T
-        double zeroRate = -std::log(df) / yearFraction * 100.0; // En porcentaje
+        double zeroRate = -fastmath::log(df) / yearFraction * 100.0; // En porcentaje
 
-        zeroRates.push_back(zeroRate);
-        maturitiesInYears.push_back(yearFraction);
-        maturities.push_back(maturityDate);
-    }
+        zeroRates_.push_back(zeroRate);
 
-    // Crear y retornar la curva calibrada
-    return std::make_shared<ZeroCouponCurve>(baseDate_, zeroRates, maturities);
+        // z = -100 ln(DF) / T
+        for (size_t k = 0; k <= i; ++k) {
+            zeroRateJacobian_[i][k] = -100.0 * discountFactorJacobian_[i][k] / (df * yearFraction);
+        }
+        maturitiesInYears_.push_back(yearFraction);
+    }
 }
 
-// Método para construir fechas de pago
+// Método para construir fechas de pago (incluye la fecha de inicio)
 std::vector<boost::gregorian::date> CurveCalibrator::buildPaymentDates(
     const boost::gregorian::date &start,
-    const boost::gregorian::date &end,
+    int months,
     int frequency)
 {
+    int periods = schedule::periodsForTenor(frequency, months);
 
     std::vector<boost::gregorian::date> dates;
-    int monthsPerPeriod = 12 / frequency;
+    dates.reserve(periods + 1);
+    dates.push_back(start);
 
-    boost::gregorian::date current = start;
-    dates.push_back(current);
-
-    while (current < end)
-    {
-        current = current + boost::gregorian::months(monthsPerPeriod);
-        dates.push_back(current);
-    }
+    schedule::forEachPaymentDate(start, frequency, periods,
+                                 [&dates](int, const boost::gregorian::date &paymentDate)
+                                 {
+                                     dates.push_back(paymentDate);
+                                 });
 
     return dates;
 }
@@ -240,7 +374,8 @@ std::vector<boost::gregorian::date> CurveCalibrator::buildPaymentDates(
 double CurveCalibrator::interpolateDiscountFactor(
     double targetYearFraction,
     const std::vector<double> &maturities,
-    const std::vector<double> &discountFactors)
+    const std::vector<double> &discountFactors,
+    InterpolationSensitivity *sensitivity)
 {
 
     // Encontrar los dos puntos más cercanos
@@ -252,11 +387,15 @@ double CurveCalibrator::interpolateDiscountFactor(
 
     if (i == 0)
     {
+        if (sensitivity)
+            *sensitivity = {0, 0, 1.0, 0.0};
         return discountFactors[0];
     }
 
     if (i == maturities.size())
     {
+        if (sensitivity)
+            *sensitivity = {i - 1, i - 1, 1.0, 0.0};
         return discountFactors.back();
     }
 
@@ -277,21 +416,28 @@ double CurveCalibrator::interpolateDiscountFactor(
          * Fórmula: DF(t) = exp(ln(DF(t0)) * (t1 - t) / (t1 - t0) + ln(DF(t1)) * (t - t0) / (t1 - t0))
          */
         // Paso 1: Convertir factores de descuento a tasas
-        double r0 = -std::log(df0) / t0;
-        double r1 = -std::log(df1) / t1;
+        double r0 = -fastmath::log(df0) / t0;
+        double r1 = -fastmath::log(df1) / t1;
 
         // Paso 2: Aplicar interpolación log-lineal en las tasas
         double weight1 = (targetYearFraction - t0) / (t1 - t0);
         double weight0 = (t1 - targetYearFraction) / (t1 - t0);
 
-        double lnr0 = std::log(r0);
-        double lnr1 = std::log(r1);
+        double lnr0 = fastmath::log(r0);
+        double lnr1 = fastmath::log(r1);
 
         double lnrT = weight1 * lnr1 + weight0 * lnr0;
-        double rT = std::exp(lnrT);
+        double rT = fastmath::exp(lnrT);
 
         // Paso 3: Convertir la tasa interpolada de vuelta a factor de descuento
-        return std::exp(-rT * targetYearFraction);
+        double df = fastmath::exp(-rT * targetYearFraction);
+
+        // ∂DF/∂DF_k = DF * t * rT * w_k / (r_k * t_k * DF_k)
+        if (sensitivity)
+            *sensitivity = {i - 1, i,
+                            df * targetYearFraction * rT * weight0 / (r0 * t0 * df0),
+                            df * targetYearFraction * rT * weight1 / (r1 * t1 * df1)};
+        return df;
     }
     else
     { // Interpolación lineal (predeterminada)
@@ -302,6 +448,38 @@ double CurveCalibrator::interpolateDiscountFactor(
          *
          * Fórmula: DF(t) = DF(t0) + (t - t0) * (DF(t1) - DF(t0)) / (t1 - t0)
          */
+        double weight1 = (targetYearFraction - t0) / (t1 - t0);
+        if (sensitivity)
+            *sensitivity = {i - 1, i, 1.0 - weight1, weight1};
         return df0 + (targetYearFraction - t0) * (df1 - df0) / (t1 - t0);
     }
-}
\ No newline at end of file
+}
+std::vector<double> CurveCalibrator::quoteRisk(const std::vector<double> &zeroRateRisk) const
+{
+    return transposeProduct(zeroRateJacobian_, zeroRateRisk);
+}
+
+std::vector<double> CurveCalibrator::quoteRiskFromDiscountFactors(const std::vector<double> &discountFactorRisk) const
+{
+    return transposeProduct(discountFactorJacobian_, discountFactorRisk);
+}
+
+// Jᵀ * riesgo, aprovechando que J es triangular inferior
+std::vector<double> CurveCalibrator::transposeProduct(const std::vector<std::vector<double>> &jacobian,
+                                                      const std::vector<double> &risk)
+{
+    if (risk.size() != jacobian.size())
+    {
+        throw std::invalid_argument("El riesgo debe tener un valor por pilar de la última calibración");
+    }
+
+    std::vector<double> result(jacobian.size(), 0.0);
+    for (size_t i = 0; i < jacobian.size(); ++i)
+    {
+        for (size_t j = 0; j <= i; ++j)
+        {
+            result[j] += risk[i] * jacobian[i][j];
+        }
+    }
+    return result;
+}
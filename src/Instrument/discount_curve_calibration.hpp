@@ -3,7 +3,7 @@
 
 #include "zero_coupon_curve.hpp"
 #include "actual_360.hpp"
-#include "factory.hpp"
+#include "instrument_variant.hpp"
 #include "instrument_description.hpp"
 #include "bond.hpp"
 #include "swap.hpp"
@@ -13,6 +13,8 @@
 #include <string>
 #include <boost/date_time/gregorian/gregorian.hpp>
 
+class CurveHandle;
+
 // Añadir enum para el tipo de interpolación
 enum class InterpolationMethod {
     Linear,
@@ -28,30 +30,107 @@ public:
     void addDeposit(double rate, int months);
     void addSwap(double rate, int months, int fixedFrequency = 2, int floatingFrequency = 2);
     std::shared_ptr<ZeroCouponCurve> calibrate();
+
+    /* Recalibra con nuevas cotizaciones (en %) los mismos instrumentos de la
+     * última calibrate() y republica el resultado en curve (con updateZeroRates).
+     * Las cotizaciones van en el orden de los pilares, el mismo que las columnas
+     * de los jacobianos. Reutiliza el plan del bootstrap y el espacio de trabajo
+     * del calibrador, así que no reserva memoria (con las trazas desactivadas).
+     * Cada hilo debe usar su propio calibrador. La curva se modifica en sitio,
+     * así que no puede tener lectores concurrentes ni estar publicada en un
+     * CurveHandle (ver ZeroCouponCurve::updateZeroRates).
+     */
+    void recalibrate(const std::vector<double>& rates, ZeroCouponCurve& curve);
+
+    /* Igual, pero construye una curva nueva y la publica en handle, de modo que
+     * los lectores que estén valorando siguen con la curva anterior. Reserva
+     * memoria para la curva nueva.
+     */
+    void recalibrate(const std::vector<double>& rates, CurveHandle& handle);
     
     // Setter para cambiar el método de interpolación
     void setInterpolationMethod(InterpolationMethod method) { interpolationMethod_ = method; }
-    
+
+    // Activa o desactiva las trazas por consola (desactivadas en calibraciones masivas)
+    void setVerbose(bool verbose) { verbose_ = verbose; }
+
+    /* Jacobianos de la última calibración respecto a las cotizaciones (en %).
+     * Fila i: pilar i de la curva; columna j: cotización que fija el pilar j
+     * (los instrumentos se ordenan por vencimiento al calibrar). El bootstrap
+     * hace que sean triangulares inferiores.
+     *   zeroRateJacobian()[i][j]       = ∂z_i / ∂q_j (tasa cero en %)
+     *   discountFactorJacobian()[i][j] = ∂DF_i / ∂q_j
+     */
+    const std::vector<std::vector<double>>& zeroRateJacobian() const { return zeroRateJacobian_; }
+    const std::vector<std::vector<double>>& discountFactorJacobian() const { return discountFactorJacobian_; }
+
+    // Riesgo por pilar -> riesgo por cotización: quote_j = Σ_i pillar_i * J[i][j].
+    // Con zeroRateRisk = ∂V/∂z_i (z en %) el resultado es ∂V/∂q_j (q en %).
+    std::vector<double> quoteRisk(const std::vector<double>& zeroRateRisk) const;
+    std::vector<double> quoteRiskFromDiscountFactors(const std::vector<double>& discountFactorRisk) const;
+
 private:
+    // Derivadas del factor interpolado respecto a los dos pilares que lo determinan
+    struct InterpolationSensitivity {
+        size_t lower = 0;
+        size_t upper = 0;
+        double dLower = 0.0;
+        double dUpper = 0.0;
+    };
+
+    // Paso del bootstrap de un pilar, precalculado en calibrate()
+    struct BootstrapStep {
+        bool deposit = false;
+        int months = 0;
+        double yearFraction = 0.0;
+        double finalAccrual = 0.0;   // Solo swaps: devengo del último periodo
+        size_t firstPeriod = 0;      // Solo swaps: periodos intermedios en
+        size_t lastPeriod = 0;       // periodTimes_/periodAccruals_
+    };
+
     boost::gregorian::date baseDate_;
     std::unique_ptr<DayCountCalculator> dayCalculator_;
-    std::vector<std::unique_ptr<Instrument>> instruments_;
+    std::vector<InstrumentVariant> instruments_;
     std::map<size_t, double> instrumentRates_;
     std::map<size_t, int> maturitiesInMonths_;
     
     // Nuevo miembro para el método de interpolación
     InterpolationMethod interpolationMethod_;
+    bool verbose_;
+
+    std::vector<std::vector<double>> zeroRateJacobian_;
+    std::vector<std::vector<double>> discountFactorJacobian_;
+
+    // Plan del bootstrap (solo depende del calendario de los instrumentos)
+    std::vector<BootstrapStep> steps_;
+    std::vector<double> periodTimes_;
+    std::vector<double> periodAccruals_;
+    std::vector<boost::gregorian::date> maturityDates_;
+
+    // Espacio de trabajo reutilizado entre calibraciones
+    std::vector<double> zeroRates_;
+    std::vector<double> maturitiesInYears_;
+    std::vector<double> discountFactors_;
+    std::vector<double> sumGradient_;
+
+    void buildBootstrapPlan();
+    void bootstrap();
+    void bootstrapQuotes(const std::vector<double>& rates);
 
     std::vector<boost::gregorian::date> buildPaymentDates(
         const boost::gregorian::date& start,
-        const boost::gregorian::date& end,
+        int months,
         int frequency);
     
     // Método modificado para incluir el tipo de interpolación
     double interpolateDiscountFactor(
         double targetYearFraction,
         const std::vector<double>& maturities,
-        const std::vector<double>& discountFactors);
+        const std::vector<double>& discountFactors,
+        InterpolationSensitivity* sensitivity = nullptr);
+
+    static std::vector<double> transposeProduct(const std::vector<std::vector<double>>& jacobian,
+                                                const std::vector<double>& risk);
 };
 
 #endif // DISCOUNT_CURVE_CALIBRATION_HPP
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include "factory_registrator.hpp"
 #include "bond_builder.hpp"
 #include "swap_builder.hpp"
+#include "instrument_variant.hpp"
+#include <type_traits>
 
 template<>
 FactoryRegistrator<BondBuilder>::FactoryRegistrator() {
@@ -14,4 +16,9 @@ FactoryRegistrator<SwapBuilder>::FactoryRegistrator() {
 
 // Definir explícitamente las especializaciones
 template class FactoryRegistrator<BondBuilder>;
-template class FactoryRegistrator<SwapBuilder>;
\ No newline at end of file
+template class FactoryRegistrator<SwapBuilder>;
+
+// InstrumentBuilders (instrument_variant.hpp) lista a mano los mismos builders:
+// al añadir uno hay que especializarlo aquí y añadirlo a la lista
+static_assert(std::is_same<InstrumentBuilders, BuilderList<BondBuilder, SwapBuilder>>::value,
+              "InstrumentBuilders no coincide con los builders registrados en la factoría");
@@ -0,0 +1,79 @@
+#include "forward_valuation_grid.hpp"
+#include "cashflow.hpp"
+#include "parallel_for.hpp"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+ForwardValuationGrid::ForwardValuationGrid(std::shared_ptr<ZeroCouponCurve> curve,
+                                           std::vector<boost::gregorian::date> dates,
+                                           unsigned threads)
+    : curve_(std::move(curve)), dates_(std::move(dates)), threads_(threads) {
+    if (!curve_) throw std::invalid_argument("ForwardValuationGrid necesita una curva");
+    if (threads_ == 0) threads_ = std::max(1u, std::thread::hardware_concurrency());
+
+    for (size_t i = 0; i < dates_.size(); ++i) {
+        if (dates_[i] < curve_->getIssueDate() || (i > 0 && dates_[i] <= dates_[i - 1])) {
+            throw std::invalid_argument("Las fechas de la rejilla deben ser crecientes y posteriores a la curva");
+        }
+        double horizon = (dates_[i] - curve_->getIssueDate()).days() / 360.0;
+        horizons_.push_back(horizon);
+        horizonDiscounts_.push_back(curve_->getDiscountFactor(horizon));
+    }
+}
+
+std::vector<double> ForwardValuationGrid::compute(const std::vector<const Instrument*>& trades) const {
+    std::vector<double> values;
+    compute(trades, values);
+    return values;
+}
+
+void ForwardValuationGrid::compute(const std::vector<const Instrument*>& trades,
+                                   std::vector<double>& values) const {
+    const size_t columns = dates_.size();
+    values.assign(trades.size() * columns, 0.0);
+
+    const size_t blocks = (trades.size() + kBlockTrades - 1) / kBlockTrades;
+
+    // Buffers de cada hilo, reutilizados entre trades
+    struct Scratch {
+        CashflowBuffer buffer;
+        std::vector<size_t> order;
+        std::vector<double> tailSums;
+    };
+
+    parallelFor<Scratch>(blocks, threads_, [&](Scratch& scratch, size_t block) {
+        CashflowBuffer& buffer = scratch.buffer;
+        std::vector<size_t>& order = scratch.order;
+        std::vector<double>& tailSums = scratch.tailSums;
+
+        size_t end = std::min(trades.size(), (block + 1) * kBlockTrades);
+        for (size_t trade = block * kBlockTrades; trade < end; ++trade) {
+            buffer.clear();
+            trades[trade]->cashflows(*curve_, buffer);
+            const size_t n = buffer.size();
+
+            // Flujos por tiempo (los swaps mezclan pata fija y flotante)
+            order.resize(n);
+            std::iota(order.begin(), order.end(), size_t{0});
+            std::sort(order.begin(), order.end(),
+                      [&buffer](size_t a, size_t b) { return buffer.time(a) < buffer.time(b); });
+
+            tailSums.assign(n + 1, 0.0);
+            for (size_t k = n; k-- > 0;) {
+                size_t i = order[k];
+                tailSums[k] = tailSums[k + 1]
+                            + buffer.amount(i) * curve_->getDiscountFactor(buffer.time(i));
+            }
+
+            double* row = values.data() + trade * columns;
+            size_t k = 0;
+            for (size_t d = 0; d < columns; ++d) {
+                while (k < n && buffer.time(order[k]) <= horizons_[d]) ++k;
+                if (k == n) break;
+                row[d] = tailSums[k] / horizonDiscounts_[d];
+            }
+        }
+    });
+}
@@ -0,0 +1,46 @@
+#ifndef FORWARD_VALUATION_GRID_HPP
+#define FORWARD_VALUATION_GRID_HPP
+
+#include "instrument.hpp"
+#include "zero_coupon_curve.hpp"
+#include <boost/date_time/gregorian/gregorian.hpp>
+#include <memory>
+#include <vector>
+
+/* Perfil de valor futuro implícito en la curva (sin simulación).
+ *
+ * El valor de un trade en la fecha g (h años desde la fecha de la curva) es
+ *   V(h) = Σ_{t_i > h} CF_i * DF(t_i) / DF(h)
+ * con los flujos proyectados hoy (ver Instrument::cashflows). Por trade se
+ * descuenta cada flujo una sola vez y se acumula de atrás hacia delante
+ * (S_k = Σ_{i >= k} CF_i * DF(t_i)); cada fecha de la rejilla es entonces un
+ * avance de puntero y una división. La matriz trades x fechas se reparte entre
+ * hilos por bloques de trades contiguos, de modo que cada hilo escribe filas
+ * completas y reutiliza sus buffers.
+ */
+class ForwardValuationGrid {
+public:
+    static const std::size_t kBlockTrades = 64;
+
+    // Las fechas deben ser crecientes y no anteriores a la de la curva.
+    // threads = 0 usa todos los núcleos disponibles.
+    ForwardValuationGrid(std::shared_ptr<ZeroCouponCurve> curve,
+                         std::vector<boost::gregorian::date> dates,
+                         unsigned threads = 0);
+
+    const std::vector<boost::gregorian::date>& dates() const { return dates_; }
+    const std::vector<double>& horizons() const { return horizons_; }
+
+    // values[trade * dates().size() + fecha]; 0 en las fechas posteriores al último flujo
+    void compute(const std::vector<const Instrument*>& trades, std::vector<double>& values) const;
+    std::vector<double> compute(const std::vector<const Instrument*>& trades) const;
+
+private:
+    std::shared_ptr<ZeroCouponCurve> curve_;
+    std::vector<boost::gregorian::date> dates_;
+    std::vector<double> horizons_;
+    std::vector<double> horizonDiscounts_;   // DF(h) de cada fecha, común a todos los trades
+    unsigned threads_;
+};
+
+#endif // FORWARD_VALUATION_GRID_HPP
@@ -0,0 +1,101 @@
+#include "historical_curve_builder.hpp"
+#include "parallel_for.hpp"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <map>
+#include <algorithm>
+#include <thread>
+#include <stdexcept>
+
+HistoricalCurveBuilder::HistoricalCurveBuilder(unsigned threads, InterpolationMethod method)
+    : threads_(threads), method_(method) {
+    if (threads_ == 0) threads_ = std::max(1u, std::thread::hardware_concurrency());
+}
+
+std::vector<QuoteSet> HistoricalCurveBuilder::readQuotes(std::istream& input) {
+    std::vector<QuoteSet> quoteSets;
+    std::map<std::pair<boost::gregorian::date, std::string>, size_t> index;
+
+    std::string line;
+    while (std::getline(input, line)) {
+        if (line.empty() || line[0] == '#' || line.compare(0, 4, "date") == 0) continue;
+
+        std::vector<std::string> fields;
+        std::stringstream ss(line);
+        std::string field;
+        while (std::getline(ss, field, ',')) fields.push_back(field);
+        if (fields.size() < 5) throw std::invalid_argument("Línea de cotización inválida: " + line);
+
+        boost::gregorian::date date = boost::gregorian::from_simple_string(fields[0]);
+        const std::string& currency = fields[1];
+
+        CurveQuote quote;
+        if (fields[2] == "DEPOSIT") quote.kind = CurveQuote::deposit;
+        else if (fields[2] == "SWAP") quote.kind = CurveQuote::swap;
+        else throw std::invalid_argument("Tipo de cotización desconocido: " + fields[2]);
+        quote.months = std::stoi(fields[3]);
+        quote.rate = std::stod(fields[4]);
+        if (fields.size() > 5) quote.fixedFrequency = std::stoi(fields[5]);
+
+        auto key = std::make_pair(date, currency);
+        auto it = index.find(key);
+        if (it == index.end()) {
+            it = index.emplace(key, quoteSets.size()).first;
+            quoteSets.push_back(QuoteSet{date, currency, {}});
+        }
+        quoteSets[it->second].quotes.push_back(quote);
+    }
+    return quoteSets;
+}
+
+std::vector<QuoteSet> HistoricalCurveBuilder::readQuotes(const std::string& path) {
+    std::ifstream input(path);
+    if (!input) throw std::runtime_error("No se pudo abrir el fichero de cotizaciones: " + path);
+    return readQuotes(input);
+}
+
+std::shared_ptr<ZeroCouponCurve> HistoricalCurveBuilder::calibrate(const QuoteSet& quoteSet) const {
+    CurveCalibrator calibrator(quoteSet.date, method_);
+    calibrator.setVerbose(false);
+    for (const CurveQuote& quote : quoteSet.quotes) {
+        if (quote.kind == CurveQuote::deposit) {
+            calibrator.addDeposit(quote.rate, quote.months);
+        } else {
+            calibrator.addSwap(quote.rate, quote.months, quote.fixedFrequency);
+        }
+    }
+    return calibrator.calibrate();
+}
+
+std::vector<HistoricalCurve> HistoricalCurveBuilder::build(const std::vector<QuoteSet>& quoteSets) const {
+    std::vector<HistoricalCurve> curves(quoteSets.size());
+
+    // Cada (fecha, divisa) es independiente
+    parallelFor(quoteSets.size(), threads_, [&](size_t i) {
+        curves[i] = HistoricalCurve{quoteSets[i].date, quoteSets[i].currency, calibrate(quoteSets[i])};
+    });
+    return curves;
+}
+
+void HistoricalCurveBuilder::writeCurves(std::ostream& output, const std::vector<HistoricalCurve>& curves) {
+    output << "date,currency,pillar,year_fraction,zero_rate,discount_factor\n";
+    output << std::setprecision(12);
+    for (const HistoricalCurve& entry : curves) {
+        const ZeroCouponCurve& curve = *entry.curve;
+        std::string date = boost::gregorian::to_iso_extended_string(entry.date);
+        for (size_t i = 0; i < curve.getMaturities().size(); ++i) {
+            output << date << ',' << entry.currency << ','
+                   << boost::gregorian::to_iso_extended_string(curve.getDates()[i]) << ','
+                   << curve.getMaturities()[i] << ','
+                   << curve.getZeroRates()[i] << ','
+                   << curve.getDiscountFactors()[i] << '\n';
+        }
+    }
+}
+
+void HistoricalCurveBuilder::writeCurves(const std::string& path, const std::vector<HistoricalCurve>& curves) {
+    std::ofstream output(path);
+    if (!output) throw std::runtime_error("No se pudo escribir el histórico de curvas: " + path);
+    writeCurves(output, curves);
+}
@@ -0,0 +1,68 @@
+#ifndef HISTORICAL_CURVE_BUILDER_HPP
+#define HISTORICAL_CURVE_BUILDER_HPP
+
+#include <vector>
+#include <memory>
+#include <string>
+#include <iosfwd>
+#include <boost/date_time/gregorian/gregorian.hpp>
+#include "discount_curve_calibration.hpp"
+#include "zero_coupon_curve.hpp"
+
+// Cotización de mercado de un instrumento de calibración
+struct CurveQuote {
+    enum Kind { deposit, swap };
+    Kind kind;
+    int months;
+    double rate;              // En porcentaje, como en CurveCalibrator
+    int fixedFrequency = 2;   // Solo swaps
+};
+
+// Conjunto de cotizaciones de una divisa en una fecha
+struct QuoteSet {
+    boost::gregorian::date date;
+    std::string currency;
+    std::vector<CurveQuote> quotes;
+};
+
+// Curva calibrada de una divisa en una fecha
+struct HistoricalCurve {
+    boost::gregorian::date date;
+    std::string currency;
+    std::shared_ptr<ZeroCouponCurve> curve;
+};
+
+/*
+ * Calibración masiva de curvas históricas
+ * =======================================
+ * Lee un fichero de cotizaciones (CSV: fecha,divisa,tipo,meses,tasa[,frecuencia]
+ * con tipo DEPOSIT o SWAP), calibra cada par (fecha, divisa) con un
+ * CurveCalibrator independiente repartiendo el trabajo entre varios hilos, y
+ * escribe el histórico de pilares resultante.
+ */
+class HistoricalCurveBuilder {
+public:
+    // threads = 0 usa todos los núcleos disponibles
+    explicit HistoricalCurveBuilder(unsigned threads = 0,
+                                    InterpolationMethod method = InterpolationMethod::Linear);
+
+    static std::vector<QuoteSet> readQuotes(std::istream& input);
+    static std::vector<QuoteSet> readQuotes(const std::string& path);
+
+    // Devuelve una curva por QuoteSet, en el mismo orden que la entrada
+    std::vector<HistoricalCurve> build(const std::vector<QuoteSet>& quoteSets) const;
+
+    // CSV: fecha,divisa,fecha_pilar,fraccion_anio,tasa_cero,factor_descuento
+    static void writeCurves(std::ostream& output, const std::vector<HistoricalCurve>& curves);
+    static void writeCurves(const std::string& path, const std::vector<HistoricalCurve>& curves);
+
+    unsigned threads() const { return threads_; }
+
+private:
+    std::shared_ptr<ZeroCouponCurve> calibrate(const QuoteSet& quoteSet) const;
+
+    unsigned threads_;
+    InterpolationMethod method_;
+};
+
+#endif // HISTORICAL_CURVE_BUILDER_HPP
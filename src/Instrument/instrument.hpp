@@ -3,6 +3,16 @@
 
 #include <memory>
 #include <string>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Versiones de las curvas de las que depende un instrumento.
+// Posición 0: curva de descuento, posición 1: curva de proyección (0 si no aplica).
+using CurveStamp = std::array<std::uint64_t, 2>;
+
+class ZeroCouponCurve;
+class CashflowBuffer;
 
 class Instrument {
 public:
@@ -10,6 +20,36 @@ public:
 
     virtual double price() const = 0;
 
+    // Identificador estable del instrumento (ver PricingCache). Es único en
+    // todo el proceso y nunca se reutiliza, aunque se reutilice la dirección.
+    // Las copias conservan el id: valoran el mismo trade.
+    std::uint64_t instrumentId() const { return id_; }
+
+    // Firma de versiones de curvas usada para memoizar precios (ver PricingCache)
+    virtual CurveStamp curveStamp() const = 0;
+
+    // Añade al buffer los flujos proyectados del instrumento (sin vaciarlo).
+    // La curva solo se usa para proyectar los flujos flotantes; el descuento
+    // se hace aparte con discountCashflows() (ver cashflow.hpp).
+    virtual void cashflows(const ZeroCouponCurve& forwardCurve, CashflowBuffer& buffer) const = 0;
+
+    // Activa o desactiva las trazas de price() por consola. Sin trazas price()
+    // no reserva memoria (ver test_allocation_free.cpp).
+    void setVerbose(bool verbose) { verbose_ = verbose; }
+    bool verbose() const { return verbose_; }
+
+protected:
+    Instrument() : id_(nextId()) {}
+
+    bool verbose_ = true;
+
+private:
+    static std::uint64_t nextId() {
+        static std::atomic<std::uint64_t> counter{0};
+        return ++counter;
+    }
+
+    std::uint64_t id_;
 };
 
-#endif // INSTRUMENT_HPP
\ No newline at end of file
+#endif // INSTRUMENT_HPP
@@ -7,14 +7,18 @@ InstrumentDescription::InstrumentDescription(Type type_) : type(type_) {}
 void InstrumentDescription::validate() const {
     if (maturity <= 0) throw std::invalid_argument("Maturity debe ser mayor a 0.");
     if (notional <= 0) throw std::invalid_argument("Notional debe ser positivo.");
-    if (!zeroCouponCurve) throw std::invalid_argument("ZeroCouponCurve no puede ser nullptr.");
+    if (!zeroCouponCurve && !curveHandle && !curveRegistry)
+        throw std::invalid_argument("ZeroCouponCurve no puede ser nullptr.");
+    if (curveRegistry && discountCurve.empty())
+        throw std::invalid_argument("Curva de descuento no definida.");
 
     if (type == bond) {
         if (couponRate < 0 || couponRate > 1) 
             throw std::invalid_argument("Coupon rate fuera de rango (0-1).");
-        if (couponDates.empty()) 
+        // Un bono cupón cero (los depósitos del calibrador) solo paga el principal
+        if (couponRate > 0 && couponDates.empty()) 
             throw std::invalid_argument("El bono debe tener fechas de cupón.");
-        if (frequency <= 0) 
+        if (couponRate > 0 && frequency <= 0) 
             throw std::invalid_argument("Frecuencia de cupón inválida.");
     } 
     else if (type == swap) {
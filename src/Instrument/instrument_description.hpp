@@ -7,6 +7,8 @@
 #include <stdexcept>
 #include <boost/date_time/gregorian/gregorian.hpp>
 #include "zero_coupon_curve.hpp"
+#include "curve_handle.hpp"
+#include "curve_registry.hpp"
 
 struct InstrumentDescription {
     enum Type { bond, swap };
@@ -27,12 +29,19 @@ struct InstrumentDescription {
     double fixedFrequency = 0.0;     // Frecuencia de la pata fija
     double floatingFrequency = 0.0;  // Frecuencia de la pata flotante
     double initialFixing = 0.0;      // Fixing inicial de la tasa flotante
-    std::string floatingIndex;       // Ejemplo: "Euribor6M"
+    std::string floatingIndex;       // Ejemplo: "Euribor6M" (curva de proyección en el registro)
     std::string dayCountConvention;  // ACT/360 o 30/360
 
 
     std::shared_ptr<ZeroCouponCurve> zeroCouponCurve;
 
+    // Alternativa a zeroCouponCurve: curva que se republica sin reconstruir el instrumento
+    std::shared_ptr<CurveHandle> curveHandle;
+
+    // Multicurva: descuento con la curva de colateral y proyección con la del índice
+    std::shared_ptr<CurveRegistry> curveRegistry;
+    std::string discountCurve;       // Ejemplo: "EUR-ESTR"
+
     // Constructor
     InstrumentDescription(Type type_);
     
@@ -0,0 +1,54 @@
+#include "instrument_variant.hpp"
+#include <optional>
+#include <stdexcept>
+
+namespace {
+
+template<typename... Builders>
+InstrumentVariant build(BuilderList<Builders...>, const InstrumentDescription& description) {
+    std::optional<InstrumentVariant> instrument;
+    // Se prueba cada builder de la lista en orden; el primero que coincide construye
+    bool found = ((description.type == Builders::getId() &&
+                   (instrument.emplace(std::in_place_type<typename Builders::Product>,
+                                       Builders::buildValue(description)), true)) || ...);
+    if (!found) throw std::runtime_error("No hay builder para el tipo de instrumento.");
+    return std::move(*instrument);
+}
+
+} // namespace
+
+InstrumentVariant makeInstrument(const InstrumentDescription& description) {
+    return build(InstrumentBuilders(), description);
+}
+
+std::size_t InstrumentBook::add(const InstrumentDescription& description) {
+    return add(makeInstrument(description));
+}
+
+std::size_t InstrumentBook::add(InstrumentVariant instrument) {
+    std::size_t position = size_;
+    std::visit([this, position](auto& concrete) {
+        using Product = std::decay_t<decltype(concrete)>;
+        auto& group = std::get<Group<Product>>(groups_);
+        concrete.setVerbose(false);
+        group.items.push_back(std::move(concrete));
+        group.positions.push_back(position);
+    }, instrument);
+    ++size_;
+    return position;
+}
+
+void InstrumentBook::price(std::vector<double>& results) const {
+    results.resize(size_);
+    // Bond y Swap son final: price() se resuelve en compilación
+    forEach([&results](const auto& instrument, std::size_t position) {
+        results[position] = instrument.price();
+    });
+}
+
+void InstrumentBook::price(const ZeroCouponCurve& curve, std::vector<double>& results) const {
+    results.resize(size_);
+    forEach([&results, &curve](const auto& instrument, std::size_t position) {
+        results[position] = instrument.price(curve);
+    });
+}
@@ -0,0 +1,85 @@
+#ifndef INSTRUMENT_VARIANT_HPP
+#define INSTRUMENT_VARIANT_HPP
+
+#include "bond_builder.hpp"
+#include "swap_builder.hpp"
+#include "instrument_description.hpp"
+#include "zero_coupon_curve.hpp"
+#include <variant>
+#include <tuple>
+#include <vector>
+#include <cstddef>
+
+// Lista cerrada de builders, conocida en compilación. Cada builder declara su
+// Product; de la lista salen el variant de instrumentos por valor y el
+// almacenamiento agrupado por tipo de InstrumentBook.
+template<typename... Builders>
+struct BuilderList {
+    using Variant = std::variant<typename Builders::Product...>;
+
+    template<template<typename> class Group>
+    using Groups = std::tuple<Group<typename Builders::Product>...>;
+};
+
+// Los mismos builders que se registran en la factoría; factory_registrator.cpp
+// comprueba en compilación que las dos listas coinciden
+using InstrumentBuilders = BuilderList<BondBuilder, SwapBuilder>;
+
+// Instrumento por valor, sin puntero ni tabla virtual de por medio
+using InstrumentVariant = InstrumentBuilders::Variant;
+
+// Construye el instrumento por valor con el builder cuyo getId() coincide
+// con description.type. Lanza si ningún builder de la lista lo construye.
+InstrumentVariant makeInstrument(const InstrumentDescription& description);
+
+/* Cartera de instrumentos por valor para valoración masiva.
+ *
+ * Los instrumentos se guardan contiguos en un vector por tipo y la valoración
+ * recorre cada vector llamando al tipo concreto: sin llamadas virtuales,
+ * dynamic_cast ni saltos por punteros. Los resultados se devuelven en el
+ * orden de inserción. Las trazas por consola se desactivan al añadir.
+ */
+class InstrumentBook {
+public:
+    // Añade un instrumento y devuelve su posición en el libro
+    std::size_t add(const InstrumentDescription& description);
+    std::size_t add(InstrumentVariant instrument);
+
+    std::size_t size() const { return size_; }
+
+    // Instrumentos de un tipo, contiguos en orden de inserción
+    template<typename Product>
+    const std::vector<Product>& instruments() const { return std::get<Group<Product>>(groups_).items; }
+
+    // price() de cada instrumento con sus propias curvas
+    void price(std::vector<double>& results) const;
+
+    // price(curve) de cada instrumento contra una misma curva
+    void price(const ZeroCouponCurve& curve, std::vector<double>& results) const;
+
+    // Aplica f(instrumento, posición) a todo el libro, tipo a tipo
+    template<typename F>
+    void forEach(F&& f) const;
+
+private:
+    template<typename Product>
+    struct Group {
+        std::vector<Product> items;
+        std::vector<std::size_t> positions;  // Posición de cada item en el libro
+    };
+
+    InstrumentBuilders::Groups<Group> groups_;
+    std::size_t size_ = 0;
+};
+
+template<typename F>
+void InstrumentBook::forEach(F&& f) const {
+    std::apply([&f](const auto&... group) {
+        auto visitGroup = [&f](const auto& g) {
+            for (std::size_t i = 0; i < g.items.size(); ++i) f(g.items[i], g.positions[i]);
+        };
+        (visitGroup(group), ...);
+    }, groups_);
+}
+
+#endif // INSTRUMENT_VARIANT_HPP
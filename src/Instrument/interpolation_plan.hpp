@@ -0,0 +1,115 @@
+#ifndef INTERPOLATION_PLAN_HPP
+#define INTERPOLATION_PLAN_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <stdexcept>
+
+/* Plan de evaluación de interpolateDiscount (discount_curve.hpp) para una rejilla
+ * de pilares y una lista de tiempos fijas.
+ *
+ * La búsqueda del segmento y los pesos se resuelven una vez al construir el
+ * plan; después, para cualquier juego de factores de descuento en los pilares,
+ *     out_i = c_i + wLo_i * y[lo_i] + wHi_i * y[hi_i]
+ * es una lectura indexada sin búsquedas ni ramas. La extrapolación plana tras
+ * el último pilar se codifica como lo = hi con pesos (1, 0); antes del primero,
+ * la interpolación desde DF(0) = 1 como lo = hi = 0 con peso t / t_1 y
+ * c = 1 - t / t_1. Sirve para escenarios y calibración, donde cambian las tasas
+ * pero no los plazos de los pilares.
+ */
+class InterpolationPlan {
+public:
+    InterpolationPlan() = default;
+
+    InterpolationPlan(const std::vector<double>& pillars, const std::vector<double>& times)
+        : pillars_(pillars.size()) {
+        if (pillars.empty()) throw std::invalid_argument("Plan de interpolación sin pilares");
+        lo_.reserve(times.size());
+        hi_.reserve(times.size());
+        wLo_.reserve(times.size());
+        wHi_.reserve(times.size());
+        c_.reserve(times.size());
+
+        const std::uint32_t last = static_cast<std::uint32_t>(pillars.size() - 1);
+        for (double t : times) {
+            if (t < pillars.front()) {
+                double w = t / pillars.front();
+                add(0, 0, w, 0.0, 1.0 - w);
+            } else if (t >= pillars.back()) {
+                add(last, last, 1.0, 0.0);
+            } else if (t == pillars.front()) {
+                add(0, 0, 1.0, 0.0);
+            } else {
+                std::uint32_t index = static_cast<std::uint32_t>(
+                    std::lower_bound(pillars.begin(), pillars.end(), t) - pillars.begin());
+                double w = (t - pillars[index - 1]) / (pillars[index] - pillars[index - 1]);
+                add(index - 1, index, 1.0 - w, w);
+            }
+        }
+    }
+
+    std::size_t size() const { return lo_.size(); }
+    std::size_t pillars() const { return pillars_; }
+
+    // Pilares y pesos del tiempo i (el gradiente de out_i respecto a los pilares)
+    // y el término constante (no nulo solo antes del primer pilar)
+    std::uint32_t lowerPillar(std::size_t i) const { return lo_[i]; }
+    std::uint32_t upperPillar(std::size_t i) const { return hi_[i]; }
+    double lowerWeight(std::size_t i) const { return wLo_[i]; }
+    double upperWeight(std::size_t i) const { return wHi_[i]; }
+    double constant(std::size_t i) const { return c_[i]; }
+
+    // out[i] = valor interpolado en times[i] para los valores de pilar dados
+    void evaluate(const double* values, double* out) const {
+        const std::size_t n = lo_.size();
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = c_[i] + wLo_[i] * values[lo_[i]] + wHi_[i] * values[hi_[i]];
+        }
+    }
+
+    void evaluate(const std::vector<double>& values, std::vector<double>& out) const {
+        checkPillars(values);
+        out.resize(lo_.size());
+        evaluate(values.data(), out.data());
+    }
+
+    // Σ amounts_i * valor interpolado en times[i], sin materializar los valores
+    double weightedSum(const std::vector<double>& values, const std::vector<double>& amounts) const {
+        checkPillars(values);
+        if (amounts.size() != lo_.size()) {
+            throw std::invalid_argument("Número de importes distinto del número de tiempos del plan");
+        }
+        const std::size_t n = lo_.size();
+        double sum = 0.0;
+        for (std::size_t i = 0; i < n; ++i) {
+            sum += amounts[i] * (c_[i] + wLo_[i] * values[lo_[i]] + wHi_[i] * values[hi_[i]]);
+        }
+        return sum;
+    }
+
+private:
+    void add(std::uint32_t lo, std::uint32_t hi, double wLo, double wHi, double c = 0.0) {
+        lo_.push_back(lo);
+        hi_.push_back(hi);
+        wLo_.push_back(wLo);
+        wHi_.push_back(wHi);
+        c_.push_back(c);
+    }
+
+    void checkPillars(const std::vector<double>& values) const {
+        if (values.size() != pillars_) {
+            throw std::invalid_argument("Número de valores distinto del número de pilares del plan");
+        }
+    }
+
+    std::size_t pillars_ = 0;
+    std::vector<std::uint32_t> lo_;
+    std::vector<std::uint32_t> hi_;
+    std::vector<double> wLo_;
+    std::vector<double> wHi_;
+    std::vector<double> c_;
+};
+
+#endif // INTERPOLATION_PLAN_HPP
@@ -0,0 +1,243 @@
+#include "latency_harness.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <pthread.h>
+#include <sched.h>
+
+namespace {
+
+constexpr std::size_t kSubBuckets = std::size_t(1) << LatencyHistogram::kSubBucketBits;
+// Tramo exacto más una fila de kSubBuckets por cada potencia de dos por encima
+constexpr std::size_t kBuckets = (64 - LatencyHistogram::kSubBucketBits + 1) * kSubBuckets;
+
+using Clock = std::chrono::steady_clock;
+
+std::uint64_t nanoseconds(Clock::duration d) {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+    return ns > 0 ? static_cast<std::uint64_t>(ns) : 0;
+}
+
+void pinCurrentThread(int cpu) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE)
+        throw std::invalid_argument("Núcleo inválido para el replay: " + std::to_string(cpu));
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+        throw std::runtime_error("No se pudo fijar el hilo de replay al núcleo " + std::to_string(cpu));
+}
+
+// Espera activa hasta el instante indicado; duerme mientras falte más de 200 us
+void waitUntil(Clock::time_point when) {
+    const auto spin = std::chrono::microseconds(200);
+    auto now = Clock::now();
+    if (when - now > spin) std::this_thread::sleep_until(when - spin);
+    while (Clock::now() < when) {
+    }
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// LatencyHistogram
+// ---------------------------------------------------------------------------
+
+LatencyHistogram::LatencyHistogram() : counts_(kBuckets, 0) {}
+
+std::size_t LatencyHistogram::bucketOf(std::uint64_t value) {
+    if (value < kSubBuckets) return static_cast<std::size_t>(value);
+    unsigned exponent = 63 - static_cast<unsigned>(__builtin_clzll(value));
+    unsigned shift = exponent - kSubBucketBits;
+    std::size_t sub = static_cast<std::size_t>(value >> shift) - kSubBuckets;
+    return (shift + 1) * kSubBuckets + sub;
+}
+
+std::uint64_t LatencyHistogram::highestEquivalent(std::size_t bucket) {
+    if (bucket < kSubBuckets) return bucket;
+    unsigned shift = static_cast<unsigned>(bucket / kSubBuckets) - 1;
+    std::uint64_t lower = static_cast<std::uint64_t>(kSubBuckets + bucket % kSubBuckets) << shift;
+    return lower + ((std::uint64_t(1) << shift) - 1);
+}
+
+void LatencyHistogram::record(std::uint64_t value) {
+    ++counts_[bucketOf(value)];
+    min_ = count_ == 0 ? value : std::min(min_, value);
+    max_ = std::max(max_, value);
+    sum_ += value;
+    ++count_;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    if (other.count_ == 0) return;
+    for (std::size_t b = 0; b < kBuckets; ++b) counts_[b] += other.counts_[b];
+    min_ = count_ == 0 ? other.min_ : std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    sum_ += other.sum_;
+    count_ += other.count_;
+}
+
+void LatencyHistogram::reset() {
+    std::fill(counts_.begin(), counts_.end(), 0);
+    count_ = sum_ = min_ = max_ = 0;
+}
+
+std::uint64_t LatencyHistogram::percentile(double p) const {
+    if (count_ == 0) return 0;
+    p = std::min(100.0, std::max(0.0, p));
+    std::uint64_t target = static_cast<std::uint64_t>(std::ceil(p / 100.0 * static_cast<double>(count_)));
+    target = std::max<std::uint64_t>(target, 1);
+
+    std::uint64_t seen = 0;
+    for (std::size_t b = 0; b < kBuckets; ++b) {
+        seen += counts_[b];
+        if (seen >= target) return std::min(highestEquivalent(b), max_);
+    }
+    return max_;
+}
+
+// ---------------------------------------------------------------------------
+// LatencyReport
+// ---------------------------------------------------------------------------
+
+void LatencyReport::print(std::ostream& output) const {
+    auto us = [](std::uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+    auto row = [&](const char* name, const LatencyHistogram& h) {
+        output << std::left << std::setw(14) << name << std::right << std::fixed << std::setprecision(1)
+               << std::setw(10) << us(h.percentile(50.0))
+               << std::setw(10) << us(h.percentile(99.0))
+               << std::setw(10) << us(h.percentile(99.9))
+               << std::setw(10) << us(h.max()) << '\n';
+    };
+    std::ios::fmtflags flags = output.flags();
+    std::streamsize precision = output.precision();
+    output << "Ticks: " << ticks << " (latencias en us)\n";
+    output << std::left << std::setw(14) << "" << std::right << std::setw(10) << "p50" << std::setw(10) << "p99"
+           << std::setw(10) << "p99.9" << std::setw(10) << "max" << '\n';
+    row("tick->precio", tickToPrice);
+    row("calibrado", calibration);
+    row("pricing", pricing);
+    output.flags(flags);
+    output.precision(precision);
+}
+
+// ---------------------------------------------------------------------------
+// TickReplayHarness
+// ---------------------------------------------------------------------------
+
+TickReplayHarness::TickReplayHarness(const boost::gregorian::date& baseDate, std::vector<CurveQuote> quotes,
+                                     InterpolationMethod method)
+    : quotes_(std::move(quotes)), calibrator_(baseDate, method) {
+    if (quotes_.empty()) throw std::invalid_argument("El arnés necesita al menos una cotización");
+
+    // Mismo orden que los pilares del calibrador
+    std::stable_sort(quotes_.begin(), quotes_.end(),
+                     [](const CurveQuote& a, const CurveQuote& b) { return a.months < b.months; });
+
+    calibrator_.setVerbose(false);
+    for (const CurveQuote& quote : quotes_) {
+        if (quote.kind == CurveQuote::deposit) {
+            calibrator_.addDeposit(quote.rate, quote.months);
+        } else {
+            calibrator_.addSwap(quote.rate, quote.months, quote.fixedFrequency);
+        }
+        rates_.push_back(quote.rate);
+    }
+    curve_ = calibrator_.calibrate();
+}
+
+LatencyReport TickReplayHarness::replay(const std::vector<QuoteTick>& ticks, const ReplayOptions& options) {
+    for (std::size_t i = 0; i < ticks.size(); ++i) {
+        if (ticks[i].pillar >= rates_.size())
+            throw std::invalid_argument("Tick para un pilar inexistente: " + std::to_string(ticks[i].pillar));
+        if (i > 0 && ticks[i].offset < ticks[i - 1].offset)
+            throw std::invalid_argument("Ticks desordenados en la posición " + std::to_string(i));
+    }
+
+    // El hilo de replay se fija al núcleo pedido sin tocar la afinidad del llamante
+    LatencyReport report;
+    std::exception_ptr failure;
+    std::thread worker([&]() {
+        try {
+            if (options.cpu >= 0) pinCurrentThread(options.cpu);
+            run(ticks, options, report);
+        } catch (...) {
+            failure = std::current_exception();
+        }
+    });
+    worker.join();
+
+    if (failure) std::rethrow_exception(failure);
+    return report;
+}
+
+void TickReplayHarness::run(const std::vector<QuoteTick>& ticks, const ReplayOptions& options,
+                            LatencyReport& report) {
+    values_.resize(book_.size());
+    const std::uint64_t firstOffset = ticks.empty() ? 0 : ticks.front().offset;
+    const Clock::time_point start = Clock::now();
+
+    for (std::size_t i = 0; i < ticks.size(); ++i) {
+        const QuoteTick& tick = ticks[i];
+        Clock::time_point arrival;
+        if (options.paced) {
+            arrival = start + std::chrono::nanoseconds(tick.offset - firstOffset);
+            waitUntil(arrival);
+        } else {
+            arrival = Clock::now();
+        }
+
+        rates_[tick.pillar] = tick.rate;
+        Clock::time_point calibrating = Clock::now();
+        calibrator_.recalibrate(rates_, *curve_);
+        Clock::time_point calibrated = Clock::now();
+        book_.price(*curve_, values_);
+        Clock::time_point priced = Clock::now();
+
+        if (i < options.warmupTicks) continue;
+        report.tickToPrice.record(nanoseconds(priced - arrival));
+        report.calibration.record(nanoseconds(calibrated - calibrating));
+        report.pricing.record(nanoseconds(priced - calibrated));
+        ++report.ticks;
+    }
+}
+
+std::vector<QuoteTick> TickReplayHarness::readTicks(std::istream& input) {
+    std::vector<QuoteTick> ticks;
+    std::string line;
+    while (std::getline(input, line)) {
+        if (line.empty() || line[0] == '#' || line.compare(0, 6, "offset") == 0) continue;
+
+        std::vector<std::string> fields;
+        std::stringstream ss(line);
+        std::string field;
+        while (std::getline(ss, field, ',')) fields.push_back(field);
+        if (fields.size() < 3) throw std::invalid_argument("Línea de tick inválida: " + line);
+
+        double offsetUs = std::stod(fields[0]);
+        long pillar = std::stol(fields[1]);
+        if (offsetUs < 0.0 || pillar < 0) throw std::invalid_argument("Línea de tick inválida: " + line);
+
+        QuoteTick tick;
+        tick.offset = static_cast<std::uint64_t>(std::llround(offsetUs * 1000.0));
+        tick.pillar = static_cast<std::size_t>(pillar);
+        tick.rate = std::stod(fields[2]);
+        if (!ticks.empty() && tick.offset < ticks.back().offset)
+            throw std::invalid_argument("Ticks desordenados: " + line);
+        ticks.push_back(tick);
+    }
+    return ticks;
+}
+
+std::vector<QuoteTick> TickReplayHarness::readTicks(const std::string& path) {
+    std::ifstream input(path);
+    if (!input) throw std::runtime_error("No se pudo abrir el fichero de ticks: " + path);
+    return readTicks(input);
+}
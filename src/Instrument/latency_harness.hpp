@@ -0,0 +1,129 @@
+#ifndef LATENCY_HARNESS_HPP
+#define LATENCY_HARNESS_HPP
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <iosfwd>
+#include <cstdint>
+#include <cstddef>
+#include <boost/date_time/gregorian/gregorian.hpp>
+#include "discount_curve_calibration.hpp"
+#include "historical_curve_builder.hpp"
+#include "instrument_variant.hpp"
+#include "zero_coupon_curve.hpp"
+
+/* Histograma de latencias al estilo HDR.
+ *
+ * Buckets log-lineales: los valores por debajo de 2^kSubBucketBits se guardan
+ * exactos y por encima cada potencia de dos se parte en 2^kSubBucketBits
+ * tramos, así que el error relativo de cualquier percentil es < 1/128 en todo
+ * el rango de uint64. record() es O(1) y no reserva memoria.
+ */
+class LatencyHistogram {
+public:
+    static constexpr unsigned kSubBucketBits = 7;
+
+    LatencyHistogram();
+
+    void record(std::uint64_t value);
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+    std::uint64_t count() const { return count_; }
+    std::uint64_t min() const { return count_ ? min_ : 0; }
+    std::uint64_t max() const { return max_; }
+    double mean() const { return count_ ? static_cast<double>(sum_) / count_ : 0.0; }
+
+    // Menor valor v tal que al menos el p% de las muestras son <= v (con la
+    // resolución del bucket); p en [0, 100]. 0 si no hay muestras.
+    std::uint64_t percentile(double p) const;
+
+private:
+    static std::size_t bucketOf(std::uint64_t value);
+    static std::uint64_t highestEquivalent(std::size_t bucket);
+
+    std::vector<std::uint64_t> counts_;
+    std::uint64_t count_ = 0;
+    std::uint64_t sum_ = 0;
+    std::uint64_t min_ = 0;
+    std::uint64_t max_ = 0;
+};
+
+// Tick grabado: nueva cotización de un instrumento de la curva
+struct QuoteTick {
+    std::uint64_t offset;   // Nanosegundos desde el inicio de la grabación
+    std::size_t pillar;     // Instrumento, en orden de vencimiento (ver TickReplayHarness)
+    double rate;            // En porcentaje, como en CurveCalibrator
+};
+
+struct ReplayOptions {
+    int cpu = -1;                  // Núcleo al que se fija el hilo de replay (-1: sin fijar)
+    std::size_t warmupTicks = 0;   // Ticks iniciales que no se registran
+    bool paced = false;            // Respeta los offsets grabados (ver replay())
+};
+
+// Latencias de un replay, en nanosegundos
+struct LatencyReport {
+    LatencyHistogram tickToPrice;   // Llegada del tick -> libro revalorado
+    LatencyHistogram calibration;   // Recalibración de la curva (sin la espera en cola)
+    LatencyHistogram pricing;       // Revalorización del libro
+    std::size_t ticks = 0;          // Ticks registrados (sin el calentamiento)
+
+    // Tabla p50 / p99 / p99.9 / max en microsegundos
+    void print(std::ostream& output) const;
+};
+
+/*
+ * Arnés de latencia tick -> precio
+ * ================================
+ * Reproduce ticks de depósitos y swaps grabados: cada tick cambia una
+ * cotización, se recalibra la curva con CurveCalibrator::recalibrate() y se
+ * revalora el libro completo contra ella. Se registra la latencia de cada tick
+ * de extremo a extremo y la de cada fase por separado, para localizar
+ * regresiones de cola en la calibración o en el pricing.
+ *
+ * Las cotizaciones se ordenan por vencimiento al construir el arnés; ese es
+ * el orden de QuoteTick::pillar y de quotes().
+ *
+ * Con paced = false los ticks se procesan seguidos y la latencia se mide desde
+ * que se empieza a procesar cada uno. Con paced = true cada tick llega en su
+ * offset grabado y la latencia se mide desde esa llegada prevista: si el
+ * proceso se retrasa, la espera en cola cuenta (sin omisión coordinada).
+ */
+class TickReplayHarness {
+public:
+    TickReplayHarness(const boost::gregorian::date& baseDate, std::vector<CurveQuote> quotes,
+                      InterpolationMethod method = InterpolationMethod::Linear);
+
+    // Añade un trade al libro y devuelve su posición en values()
+    std::size_t add(const InstrumentDescription& description) { return book_.add(description); }
+
+    const std::vector<CurveQuote>& quotes() const { return quotes_; }
+    const InstrumentBook& book() const { return book_; }
+    std::shared_ptr<ZeroCouponCurve> curve() const { return curve_; }
+
+    // Valores del libro tras el último tick reproducido
+    const std::vector<double>& values() const { return values_; }
+
+    // Reproduce los ticks en un hilo propio (fijado a options.cpu si se pide).
+    // Lanza invalid_argument si un tick no corresponde a ningún pilar o si los
+    // offsets no están ordenados.
+    LatencyReport replay(const std::vector<QuoteTick>& ticks, const ReplayOptions& options = ReplayOptions());
+
+    // CSV: offset_us,pilar,tasa (ordenado por offset)
+    static std::vector<QuoteTick> readTicks(std::istream& input);
+    static std::vector<QuoteTick> readTicks(const std::string& path);
+
+private:
+    void run(const std::vector<QuoteTick>& ticks, const ReplayOptions& options, LatencyReport& report);
+
+    std::vector<CurveQuote> quotes_;
+    std::vector<double> rates_;   // Cotizaciones vigentes, en orden de pilares
+    CurveCalibrator calibrator_;
+    std::shared_ptr<ZeroCouponCurve> curve_;
+    InstrumentBook book_;
+    std::vector<double> values_;
+};
+
+#endif // LATENCY_HARNESS_HPP
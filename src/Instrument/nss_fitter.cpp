@@ -0,0 +1,257 @@
+#include "nss_fitter.hpp"
+#include "z_spread_solver.hpp"
+#include "parallel_for.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+const int kParameters = 6;
+
+// Flujos de todos los bonos en columnas contiguas. Los bonos comparten muchas
+// fechas de pago, así que la curva se evalúa una vez por tiempo distinto.
+struct BondColumns {
+    std::vector<std::size_t> offsets;
+    std::vector<double> amounts;
+    std::vector<std::uint32_t> timeIndex;   // Posición del tiempo del flujo en times
+    std::vector<double> times;              // Tiempos distintos, ordenados
+    std::vector<double> prices;
+    std::vector<double> weights;            // sqrt(w_k), multiplican al residuo
+};
+
+// DF y -t * DF * ∂z/∂p de cada tiempo distinto
+struct CurveSamples {
+    std::vector<double> discountFactors;
+    std::vector<double> sensitivities;   // times.size() x 6, por filas
+};
+
+NelsonSiegelSvenssonCurve curveFrom(const double p[kParameters]) {
+    return NelsonSiegelSvenssonCurve(p[0], p[1], p[2], p[3], std::exp(p[4]), std::exp(p[5]));
+}
+
+// Residuos r_k y, si jacobian no es nulo, su jacobiano (m x 6, por filas)
+double evaluate(const BondColumns& bonds, const double p[kParameters], CurveSamples& samples,
+                std::vector<double>& residuals, std::vector<double>* jacobian) {
+    NelsonSiegelSvenssonCurve curve = curveFrom(p);
+    const std::size_t u = bonds.times.size();
+    samples.discountFactors.resize(u);
+    samples.sensitivities.resize(u * kParameters);
+
+    double gradient[kParameters];
+    for (std::size_t i = 0; i < u; ++i) {
+        double t = bonds.times[i];
+        double df = curve.getDiscountFactor(t);
+        samples.discountFactors[i] = df;
+        if (jacobian) {
+            // Cadena de los taus en logaritmo: ∂/∂ln(tau) = tau * ∂/∂tau
+            curve.zeroRateGradient(t, gradient);
+            gradient[4] *= curve.tau1();
+            gradient[5] *= curve.tau2();
+            for (int j = 0; j < kParameters; ++j) samples.sensitivities[i * kParameters + j] = -t * df * gradient[j];
+        }
+    }
+
+    const std::size_t m = bonds.prices.size();
+    double cost = 0.0;
+    for (std::size_t k = 0; k < m; ++k) {
+        double price = 0.0;
+        double row[kParameters] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+        for (std::size_t i = bonds.offsets[k]; i < bonds.offsets[k + 1]; ++i) {
+            std::uint32_t index = bonds.timeIndex[i];
+            price += bonds.amounts[i] * samples.discountFactors[index];
+            if (jacobian) {
+                const double* sensitivity = &samples.sensitivities[index * kParameters];
+                for (int j = 0; j < kParameters; ++j) row[j] += bonds.amounts[i] * sensitivity[j];
+            }
+        }
+        double w = bonds.weights[k];
+        residuals[k] = w * (price - bonds.prices[k]);
+        cost += residuals[k] * residuals[k];
+        if (jacobian) {
+            for (int j = 0; j < kParameters; ++j) (*jacobian)[k * kParameters + j] = w * row[j];
+        }
+    }
+    return cost;
+}
+
+// Resuelve A x = b (6 x 6) por eliminación gaussiana con pivoteo parcial
+bool solveNormalEquations(double a[kParameters][kParameters], double b[kParameters]) {
+    for (int c = 0; c < kParameters; ++c) {
+        int pivot = c;
+        for (int r = c + 1; r < kParameters; ++r) {
+            if (std::abs(a[r][c]) > std::abs(a[pivot][c])) pivot = r;
+        }
+        if (a[pivot][c] == 0.0) return false;
+        std::swap(a[c], a[pivot]);
+        std::swap(b[c], b[pivot]);
+        for (int r = c + 1; r < kParameters; ++r) {
+            double factor = a[r][c] / a[c][c];
+            for (int k = c; k < kParameters; ++k) a[r][k] -= factor * a[c][k];
+            b[r] -= factor * b[c];
+        }
+    }
+    for (int c = kParameters - 1; c >= 0; --c) {
+        for (int k = c + 1; k < kParameters; ++k) b[c] -= a[c][k] * b[k];
+        b[c] /= a[c][c];
+    }
+    return true;
+}
+
+struct StartResult {
+    double p[kParameters];
+    double cost = std::numeric_limits<double>::infinity();
+    int iterations = 0;
+    bool converged = false;
+};
+
+// Levenberg-Marquardt desde p
+StartResult levenbergMarquardt(const BondColumns& bonds, const double initial[kParameters],
+                               int maxIterations, double tolerance) {
+    const std::size_t m = bonds.prices.size();
+    std::vector<double> residuals(m), trialResiduals(m), jacobian(m * kParameters);
+    CurveSamples samples;
+
+    StartResult result;
+    std::copy(initial, initial + kParameters, result.p);
+    result.cost = evaluate(bonds, result.p, samples, residuals, &jacobian);
+    double lambda = 1e-3;
+
+    for (int iteration = 1; iteration <= maxIterations; ++iteration) {
+        result.iterations = iteration;
+
+        // Ecuaciones normales: (JᵀJ + λ diag(JᵀJ)) δ = -Jᵀ r
+        double jtj[kParameters][kParameters] = {};
+        double jtr[kParameters] = {};
+        for (std::size_t k = 0; k < m; ++k) {
+            const double* row = &jacobian[k * kParameters];
+            for (int a = 0; a < kParameters; ++a) {
+                jtr[a] += row[a] * residuals[k];
+                for (int b = a; b < kParameters; ++b) jtj[a][b] += row[a] * row[b];
+            }
+        }
+        for (int a = 0; a < kParameters; ++a) {
+            for (int b = 0; b < a; ++b) jtj[a][b] = jtj[b][a];
+        }
+
+        bool improved = false;
+        while (lambda < 1e12) {
+            double system[kParameters][kParameters];
+            double step[kParameters];
+            for (int a = 0; a < kParameters; ++a) {
+                for (int b = 0; b < kParameters; ++b) system[a][b] = jtj[a][b];
+                system[a][a] += lambda * (jtj[a][a] + 1e-12);
+                step[a] = -jtr[a];
+            }
+            if (!solveNormalEquations(system, step)) {
+                lambda *= 10.0;
+                continue;
+            }
+
+            double trial[kParameters];
+            for (int a = 0; a < kParameters; ++a) trial[a] = result.p[a] + step[a];
+            double trialCost = evaluate(bonds, trial, samples, trialResiduals, nullptr);
+            if (std::isfinite(trialCost) && trialCost < result.cost) {
+                double decrease = result.cost - trialCost;
+                std::copy(trial, trial + kParameters, result.p);
+                result.cost = evaluate(bonds, result.p, samples, residuals, &jacobian);
+                lambda = std::max(lambda / 10.0, 1e-12);
+                improved = true;
+                if (decrease <= tolerance * (1.0 + result.cost)) result.converged = true;
+                break;
+            }
+            lambda *= 10.0;
+        }
+        // Sin mejora posible: estamos en un mínimo (local)
+        if (!improved) result.converged = true;
+        if (result.converged) break;
+    }
+    return result;
+}
+
+} // namespace
+
+NssFitter::NssFitter(unsigned threads, int maxIterations, double tolerance)
+    : threads_(threads), maxIterations_(maxIterations), tolerance_(tolerance) {
+    if (threads_ == 0) threads_ = std::max(1u, std::thread::hardware_concurrency());
+    for (double tau1 : {0.5, 1.0, 2.0, 4.0}) {
+        for (double tau2 : {3.0, 6.0, 10.0, 20.0}) {
+            if (tau2 > tau1) starts_.push_back({tau1, tau2});
+        }
+    }
+}
+
+NssFit NssFitter::fit(const std::vector<const Bond*>& bonds, const std::vector<double>& prices,
+                      const std::vector<double>& weights) const {
+    if (bonds.empty() || bonds.size() != prices.size() ||
+        (!weights.empty() && weights.size() != bonds.size())) {
+        throw std::invalid_argument("El ajuste NSS necesita un precio (y un peso) por bono");
+    }
+
+    BondColumns columns;
+    columns.offsets.push_back(0);
+    for (std::size_t k = 0; k < bonds.size(); ++k) {
+        const std::vector<double>& times = bonds[k]->getCashflowTimes();
+        const std::vector<double>& amounts = bonds[k]->getCashflowAmounts();
+        if (times.empty()) throw std::invalid_argument("El ajuste NSS necesita bonos con flujos");
+        columns.times.insert(columns.times.end(), times.begin(), times.end());
+        columns.amounts.insert(columns.amounts.end(), amounts.begin(), amounts.end());
+        columns.offsets.push_back(columns.amounts.size());
+        columns.weights.push_back(weights.empty() ? 1.0 : std::sqrt(weights[k]));
+    }
+    columns.prices = prices;
+
+    // Tiempos distintos y el índice de cada flujo en ellos
+    std::vector<double> flowTimes = std::move(columns.times);
+    columns.times = flowTimes;
+    std::sort(columns.times.begin(), columns.times.end());
+    columns.times.erase(std::unique(columns.times.begin(), columns.times.end()), columns.times.end());
+    columns.timeIndex.reserve(flowTimes.size());
+    for (double t : flowTimes) {
+        columns.timeIndex.push_back(static_cast<std::uint32_t>(
+            std::lower_bound(columns.times.begin(), columns.times.end(), t) - columns.times.begin()));
+    }
+
+    // Nivel y pendiente iniciales: rentabilidades planas del bono más largo y del más corto
+    std::vector<ZSpreadResult> yields = ZSpreadSolver().solve(bonds, prices, FlatCurve(0.0));
+    std::size_t shortest = 0, longest = 0;
+    for (std::size_t k = 0; k < bonds.size(); ++k) {
+        double maturity = bonds[k]->getCashflowTimes().back();
+        if (maturity < bonds[shortest]->getCashflowTimes().back()) shortest = k;
+        if (maturity > bonds[longest]->getCashflowTimes().back()) longest = k;
+    }
+    double level = yields[longest].spread;
+    double slope = yields[shortest].spread - level;
+
+    std::vector<StartResult> results(starts_.size());
+    parallelFor(starts_.size(), threads_, [&](std::size_t s) {
+        double initial[kParameters] = {level, slope, 0.0, 0.0,
+                                       std::log(starts_[s][0]), std::log(starts_[s][1])};
+        results[s] = levenbergMarquardt(columns, initial, maxIterations_, tolerance_);
+    });
+
+    // El primer arranque con menor coste gana: mismo resultado con cualquier número de hilos
+    std::size_t best = 0;
+    for (std::size_t s = 1; s < results.size(); ++s) {
+        if (results[s].cost < results[best].cost) best = s;
+    }
+
+    NssFit fit;
+    fit.curve = curveFrom(results[best].p);
+    fit.rmse = std::sqrt(results[best].cost / bonds.size());
+    fit.iterations = results[best].iterations;
+    fit.converged = results[best].converged;
+    fit.start = best;
+    return fit;
+}
+
+std::shared_ptr<ZeroCouponCurve> NssFitter::toZeroCouponCurve(const NelsonSiegelSvenssonCurve& curve,
+                                                              const std::vector<double>& maturities) {
+    std::vector<double> zeroRates;
+    zeroRates.reserve(maturities.size());
+    for (double t : maturities) zeroRates.push_back(curve.zeroRate(t) * 100.0);
+    return std::make_shared<ZeroCouponCurve>(zeroRates, maturities);
+}
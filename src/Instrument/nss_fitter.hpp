@@ -0,0 +1,55 @@
+#ifndef NSS_FITTER_HPP
+#define NSS_FITTER_HPP
+
+#include "bond.hpp"
+#include "discount_curve.hpp"
+#include "zero_coupon_curve.hpp"
+#include <array>
+#include <memory>
+#include <vector>
+
+// Resultado del ajuste Nelson-Siegel-Svensson
+struct NssFit {
+    NelsonSiegelSvenssonCurve curve{0.0, 0.0, 0.0, 0.0, 1.0, 1.0};
+    double rmse = 0.0;        // Error cuadrático medio de precio (ponderado)
+    int iterations = 0;       // Iteraciones del arranque ganador
+    bool converged = false;
+    std::size_t start = 0;    // Índice del arranque ganador
+};
+
+/* Ajuste de una curva Nelson-Siegel-Svensson a precios de bonos.
+ *
+ * Minimiza Σ w_k (P_k(p) - precio_k)² con Levenberg-Marquardt. El jacobiano
+ * es analítico: ∂P_k/∂p_j = -Σ CF_i t_i DF(t_i) ∂z(t_i)/∂p_j (ver
+ * NelsonSiegelSvenssonCurve::zeroRateGradient). Los taus se optimizan en
+ * logaritmo para que sigan siendo positivos.
+ *
+ * Los flujos de todos los bonos se copian una vez en columnas contiguas. El
+ * ajuste es no convexo en los taus, así que se lanza desde una rejilla de
+ * (tau1, tau2) iniciales repartida entre hilos y se queda el mejor resultado;
+ * la elección no depende del número de hilos.
+ */
+class NssFitter {
+public:
+    // threads = 0 usa todos los núcleos disponibles
+    explicit NssFitter(unsigned threads = 0, int maxIterations = 200, double tolerance = 1e-12);
+
+    // Precio sucio de cada bono; weights vacío equivale a pesos 1
+    NssFit fit(const std::vector<const Bond*>& bonds, const std::vector<double>& prices,
+               const std::vector<double>& weights = {}) const;
+
+    // Arranques (tau1, tau2) usados por fit()
+    const std::vector<std::array<double, 2>>& starts() const { return starts_; }
+
+    // Muestrea la curva en los pilares dados para usarla donde se espera una ZeroCouponCurve
+    static std::shared_ptr<ZeroCouponCurve> toZeroCouponCurve(const NelsonSiegelSvenssonCurve& curve,
+                                                              const std::vector<double>& maturities);
+
+private:
+    unsigned threads_;
+    int maxIterations_;
+    double tolerance_;
+    std::vector<std::array<double, 2>> starts_;
+};
+
+#endif // NSS_FITTER_HPP
@@ -0,0 +1,81 @@
+#ifndef PARALLEL_FOR_HPP
+#define PARALLEL_FOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/* Reparto de trabajos independientes entre hilos.
+ *
+ * parallelFor(n, threads, work) ejecuta work(i) para cada i en [0, n). Los
+ * hilos toman índices de un contador común y el llamante trabaja como uno más.
+ * Un trabajo que lanza no detiene a los demás; al terminar se relanza la
+ * primera excepción. Si no se puede crear algún hilo se sigue con los que ya
+ * están en marcha (como mínimo el llamante) y siempre se esperan todos, así
+ * que nunca queda un std::thread sin join.
+ *
+ * La variante con State da a cada hilo un State propio, construido una vez y
+ * reutilizado entre sus trabajos (buffers de trabajo): work(state, i).
+ */
+namespace detail {
+
+struct NoState {};
+
+template<typename State, typename Work>
+void parallelForImpl(std::size_t n, unsigned threads, Work& work) {
+    std::atomic<std::size_t> next{0};
+    std::exception_ptr failure;
+    std::mutex failureMutex;
+    auto fail = [&]() {
+        std::lock_guard<std::mutex> lock(failureMutex);
+        if (!failure) failure = std::current_exception();
+    };
+
+    auto worker = [&]() {
+        try {
+            State state;
+            for (std::size_t i = next++; i < n; i = next++) {
+                try {
+                    work(state, i);
+                } catch (...) {
+                    fail();
+                }
+            }
+        } catch (...) {
+            fail();
+        }
+    };
+
+    std::size_t threadCount = std::min<std::size_t>(std::max(threads, 1u), n);
+    std::vector<std::thread> pool;
+    try {
+        pool.reserve(threadCount > 0 ? threadCount - 1 : 0);
+        for (std::size_t t = 1; t < threadCount; ++t) pool.emplace_back(worker);
+    } catch (...) {
+        // Sin más hilos: los trabajos pendientes los terminan los que ya corren
+    }
+    worker();
+    for (auto& thread : pool) thread.join();
+
+    if (failure) std::rethrow_exception(failure);
+}
+
+} // namespace detail
+
+template<typename Work>
+void parallelFor(std::size_t n, unsigned threads, Work&& work) {
+    auto adapter = [&work](detail::NoState&, std::size_t i) { work(i); };
+    detail::parallelForImpl<detail::NoState>(n, threads, adapter);
+}
+
+template<typename State, typename Work>
+void parallelFor(std::size_t n, unsigned threads, Work&& work) {
+    detail::parallelForImpl<State>(n, threads, work);
+}
+
+#endif // PARALLEL_FOR_HPP
@@ -0,0 +1,128 @@
+#ifndef PORTFOLIO_AGGREGATOR_HPP
+#define PORTFOLIO_AGGREGATOR_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <thread>
+#include <vector>
+#include "parallel_for.hpp"
+
+// Suma compensada de Neumaier: acumula aparte el error de redondeo de cada suma
+struct CompensatedSum {
+    double sum = 0.0;
+    double compensation = 0.0;
+
+    void add(double x) {
+        double t = sum + x;
+        if (std::abs(sum) >= std::abs(x)) {
+            compensation += (sum - t) + x;
+        } else {
+            compensation += (x - t) + sum;
+        }
+        sum = t;
+    }
+
+    void merge(const CompensatedSum& other) {
+        add(other.sum);
+        compensation += other.compensation;
+    }
+
+    double value() const { return sum + compensation; }
+};
+
+/* Agregación reproducible de PV y vectores de riesgo de una cartera.
+ *
+ * El orden de las sumas no depende de los hilos: los trades se agrupan en
+ * hojas de kLeafSize índices consecutivos, cada hoja se suma con suma
+ * compensada y las hojas se combinan por pares en un árbol de forma fija
+ * (0+1, 2+3, ... y así por niveles). Los hilos solo deciden quién calcula cada
+ * hoja, nunca cómo se combinan, así que el resultado es idéntico bit a bit
+ * con 1 o N hilos. La valoración de cada trade se hace dentro de la hoja, de
+ * modo que el coste añadido es una suma compensada por trade.
+ */
+class PortfolioAggregator {
+public:
+    static const std::size_t kLeafSize = 256;
+
+    // threads = 0 usa todos los núcleos disponibles
+    explicit PortfolioAggregator(unsigned threads = 0)
+        : threads_(threads ? threads : std::max(1u, std::thread::hardware_concurrency())) {}
+
+    unsigned threads() const { return threads_; }
+
+    // Σ value(i) para i en [0, n); value se llama una vez por índice, en paralelo
+    template<typename Value>
+    double sum(std::size_t n, Value value) const {
+        std::vector<CompensatedSum> leaves((n + kLeafSize - 1) / kLeafSize);
+        forEachLeaf(leaves.size(), [&](std::size_t leaf) {
+            std::size_t end = std::min(n, (leaf + 1) * kLeafSize);
+            for (std::size_t i = leaf * kLeafSize; i < end; ++i) {
+                leaves[leaf].add(value(i));
+            }
+        });
+        return reduce(leaves, 1)[0].value();
+    }
+
+    double sum(const std::vector<double>& values) const {
+        return sum(values.size(), [&values](std::size_t i) { return values[i]; });
+    }
+
+    // Σ contribute(i) de vectores de width componentes (p. ej. riesgo por pilar).
+    // contribute(i, out) escribe la contribución del trade i en out[0..width).
+    template<typename Contribution>
+    std::vector<double> sumVectors(std::size_t n, std::size_t width, Contribution contribute) const {
+        std::size_t leafCount = (n + kLeafSize - 1) / kLeafSize;
+        std::vector<CompensatedSum> leaves(leafCount * width);
+        forEachLeaf(leafCount, [&](std::size_t leaf) {
+            std::vector<double> scratch(width);
+            CompensatedSum* sums = leaves.data() + leaf * width;
+            std::size_t end = std::min(n, (leaf + 1) * kLeafSize);
+            for (std::size_t i = leaf * kLeafSize; i < end; ++i) {
+                std::fill(scratch.begin(), scratch.end(), 0.0);
+                contribute(i, scratch.data());
+                for (std::size_t k = 0; k < width; ++k) sums[k].add(scratch[k]);
+            }
+        });
+
+        std::vector<CompensatedSum> total = reduce(leaves, width);
+        std::vector<double> result(width);
+        for (std::size_t k = 0; k < width; ++k) result[k] = total[k].value();
+        return result;
+    }
+
+private:
+    // Ejecuta work(hoja) para todas las hojas repartidas entre los hilos
+    template<typename Work>
+    void forEachLeaf(std::size_t leafCount, Work work) const {
+        parallelFor(leafCount, threads_, work);
+    }
+
+    // Árbol por pares de forma fija sobre hojas de width componentes
+    static std::vector<CompensatedSum> reduce(std::vector<CompensatedSum> level, std::size_t width) {
+        if (level.empty()) return std::vector<CompensatedSum>(width);
+        std::size_t count = level.size() / width;
+        while (count > 1) {
+            std::size_t half = (count + 1) / 2;
+            for (std::size_t pair = 0; pair < count / 2; ++pair) {
+                for (std::size_t k = 0; k < width; ++k) {
+                    CompensatedSum merged = level[2 * pair * width + k];
+                    merged.merge(level[(2 * pair + 1) * width + k]);
+                    level[pair * width + k] = merged;
+                }
+            }
+            if (count % 2) {
+                for (std::size_t k = 0; k < width; ++k) {
+                    level[(half - 1) * width + k] = level[(count - 1) * width + k];
+                }
+            }
+            count = half;
+        }
+        level.resize(width);
+        return level;
+    }
+
+    unsigned threads_;
+};
+
+#endif // PORTFOLIO_AGGREGATOR_HPP
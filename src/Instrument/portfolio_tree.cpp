@@ -0,0 +1,209 @@
+#include "portfolio_tree.hpp"
+#include "factory.hpp"
+#include "bond.hpp"
+#include "swap.hpp"
+#include "cashflow.hpp"
+#include "discount_curve.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+const double kBasisPoint = 1e-4;
+
+// Swap multicurva: flujos proyectados con forward y descontados con discount
+template<typename DiscountCurve, typename ForwardCurve>
+double twoCurveValue(const Swap& swap, const DiscountCurve& discount, const ForwardCurve& forward,
+                     CashflowBuffer& buffer) {
+    buffer.clear();
+    swap.projectCashflows(forward, buffer);
+    return discountCashflows(discount, buffer);
+}
+
+} // namespace
+
+PortfolioTree::PortfolioTree(const std::string& rootName) {
+    nodes_.emplace_back(rootName, kRoot, 0);
+}
+
+PortfolioTree::NodeId PortfolioTree::addNode(NodeId parent, const std::string& name) {
+    Node& parentNode = nodes_.at(parent);
+    auto it = parentNode.children.find(name);
+    if (it != parentNode.children.end()) return it->second;
+
+    NodeId id = static_cast<NodeId>(nodes_.size());
+    std::size_t depth = parentNode.depth + 1;
+    parentNode.children.emplace(name, id);
+    nodes_.emplace_back(name, parent, depth);
+    return id;
+}
+
+PortfolioTree::TradeId PortfolioTree::addTrade(NodeId node, const InstrumentDescription& description) {
+    if (node >= nodes_.size()) throw std::out_of_range("Nodo de cartera inexistente");
+
+    Trade trade = makeTrade(node, description);
+    trade.value = value(trade);
+
+    TradeId id = nextTrade_++;
+    Trade& stored = trades_.emplace(id, std::move(trade)).first->second;
+    try {
+        link(id, stored);
+    } catch (...) {
+        trades_.erase(id);
+        throw;
+    }
+    propagate(node, stored.value, 1);
+    return id;
+}
+
+void PortfolioTree::amendTrade(TradeId id, const InstrumentDescription& description) {
+    Trade& trade = trades_.at(id);
+
+    // Se construye, valora y enlaza antes de soltar las curvas antiguas: si algo
+    // falla, la cartera no cambia
+    Trade amended = makeTrade(trade.node, description);
+    amended.value = value(amended);
+    link(id, amended, trade.curves);
+    unlink(id, trade.curves, amended.curves);
+
+    PortfolioValue delta{amended.value.pv - trade.value.pv, amended.value.dv01 - trade.value.dv01};
+    trade = std::move(amended);
+    propagate(trade.node, delta, 0);
+}
+
+void PortfolioTree::cancelTrade(TradeId id) {
+    auto it = trades_.find(id);
+    if (it == trades_.end()) throw std::out_of_range("Trade inexistente");
+
+    const Trade& trade = it->second;
+    unlink(id, trade.curves);
+    propagate(trade.node, {-trade.value.pv, -trade.value.dv01}, -1);
+    trades_.erase(it);
+}
+
+void PortfolioTree::curveUpdated(const ZeroCouponCurve& curve) {
+    revalue(&curve);
+}
+
+void PortfolioTree::curveUpdated(const CurveHandle& handle) {
+    revalue(&handle);
+}
+
+void PortfolioTree::curveUpdated(const CurveRegistry& registry, const std::string& curveName) {
+    revalue(&registry.handle(registry.find(curveName)));
+}
+
+PortfolioValue PortfolioTree::total(NodeId node) const {
+    const Node& n = nodes_.at(node);
+    return {n.pv.value(), n.dv01.value()};
+}
+
+void PortfolioTree::revalue(const void* curveKey) {
+    auto it = dependents_.find(curveKey);
+    if (it == dependents_.end()) return;
+
+    for (TradeId id : it->second) {
+        Trade& trade = trades_.at(id);
+        PortfolioValue updated = value(trade);
+        propagate(trade.node, {updated.pv - trade.value.pv, updated.dv01 - trade.value.dv01}, 0);
+        trade.value = updated;
+    }
+}
+
+void PortfolioTree::propagate(NodeId node, const PortfolioValue& delta, long tradeCount) {
+    for (;;) {
+        Node& n = nodes_[node];
+        n.pv.add(delta.pv);
+        n.dv01.add(delta.dv01);
+        n.trades += tradeCount;
+        if (node == kRoot) break;
+        node = n.parent;
+    }
+}
+
+PortfolioTree::Trade PortfolioTree::makeTrade(NodeId node, const InstrumentDescription& description) const {
+    Trade trade{node, description, Factory::instance()(description)};
+    trade.bond = dynamic_cast<const Bond*>(trade.instrument.get());
+    trade.swap = dynamic_cast<const Swap*>(trade.instrument.get());
+    if (!trade.bond && !trade.swap) throw std::invalid_argument("PortfolioTree solo admite bonos y swaps");
+
+    const InstrumentDescription& d = trade.description;
+    if (d.curveRegistry) {
+        trade.discountId = d.curveRegistry->find(d.discountCurve);
+        trade.forwardId = trade.swap ? d.curveRegistry->find(d.floatingIndex) : trade.discountId;
+    }
+    return trade;
+}
+
+void PortfolioTree::link(TradeId id, Trade& trade, const std::vector<const void*>& keep) {
+    // Claves primero (puede lanzar sin haber tocado nada)
+    const InstrumentDescription& d = trade.description;
+    std::vector<const void*> curves;
+    if (d.curveRegistry) {
+        curves.push_back(&d.curveRegistry->handle(trade.discountId));
+        if (trade.forwardId != trade.discountId) curves.push_back(&d.curveRegistry->handle(trade.forwardId));
+    } else if (d.curveHandle) {
+        curves.push_back(d.curveHandle.get());
+    } else {
+        curves.push_back(d.zeroCouponCurve.get());
+    }
+
+    std::size_t linked = 0;
+    try {
+        for (; linked < curves.size(); ++linked) dependents_[curves[linked]].insert(id);
+    } catch (...) {
+        curves.resize(linked);
+        unlink(id, curves, keep);
+        throw;
+    }
+    trade.curves = std::move(curves);
+}
+
+void PortfolioTree::unlink(TradeId id, const std::vector<const void*>& curves,
+                           const std::vector<const void*>& keep) {
+    for (const void* key : curves) {
+        if (std::find(keep.begin(), keep.end(), key) != keep.end()) continue;
+        auto it = dependents_.find(key);
+        if (it == dependents_.end()) continue;
+        it->second.erase(id);
+        if (it->second.empty()) dependents_.erase(it);
+    }
+}
+
+PortfolioValue PortfolioTree::value(const Trade& trade) {
+    ++repricings_;
+    const InstrumentDescription& d = trade.description;
+    const Bond* bond = trade.bond;
+    const Swap* swap = trade.swap;
+
+    // Valoración monocurva con el kernel fusionado de valor y riesgo
+    auto singleCurve = [&](const ZeroCouponCurve& curve) -> PortfolioValue {
+        if (bond) {
+            BondRisk risk = bond->risk(curve);
+            return {risk.price, risk.dv01};
+        }
+        SwapRisk risk = swap->risk(curve);
+        return {risk.npv, risk.dv01};
+    };
+
+    if (d.curveRegistry) {
+        const CurveRegistry& registry = *d.curveRegistry;
+        CurveHandle::ReadGuard discount(registry.handle(trade.discountId));
+        if (bond || trade.forwardId == trade.discountId) return singleCurve(discount.curve());
+
+        // dv01 multicurva: diferencia central con ambas curvas desplazadas en paralelo
+        CurveHandle::ReadGuard forward(registry.handle(trade.forwardId));
+        CashflowBuffer buffer;
+        double pv = twoCurveValue(*swap, discount.curve(), forward.curve(), buffer);
+        double down = twoCurveValue(*swap, makeSpreadCurve(discount.curve(), -kBasisPoint),
+                                    makeSpreadCurve(forward.curve(), -kBasisPoint), buffer);
+        double up = twoCurveValue(*swap, makeSpreadCurve(discount.curve(), kBasisPoint),
+                                  makeSpreadCurve(forward.curve(), kBasisPoint), buffer);
+        return {pv, 0.5 * (down - up)};
+    }
+    if (d.curveHandle) {
+        CurveHandle::ReadGuard guard(*d.curveHandle);
+        return singleCurve(guard.curve());
+    }
+    return singleCurve(*d.zeroCouponCurve);
+}
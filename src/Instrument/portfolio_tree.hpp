@@ -0,0 +1,114 @@
+#ifndef PORTFOLIO_TREE_HPP
+#define PORTFOLIO_TREE_HPP
+
+#include "instrument.hpp"
+#include "instrument_description.hpp"
+#include "portfolio_aggregator.hpp"
+#include "curve_registry.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// Valor y riesgo de un trade o de un nodo de la cartera
+struct PortfolioValue {
+    double pv = 0.0;
+    double dv01 = 0.0;   // Cambio de valor por -1pb de las curvas
+};
+
+/* Árbol de cartera (entidad / mesa / libro / ...) con reagregación incremental.
+ *
+ * Las hojas son trades construidos con Factory a partir de su descripción.
+ * Cada nodo guarda el total de su subárbol; un alta, modificación o baja
+ * revalora solo ese trade y suma la diferencia en sus antecesores, O(profundidad).
+ * Los totales se acumulan con suma compensada para que las ráfagas de
+ * modificaciones no arrastren error de redondeo.
+ *
+ * Cuando se republica una curva, curveUpdated() revalora solo los trades que
+ * dependen de ella (por curva, CurveHandle o nombre en el registro).
+ */
+class Bond;
+class Swap;
+
+class PortfolioTree {
+public:
+    using NodeId = std::uint32_t;
+    using TradeId = std::uint64_t;
+    static constexpr NodeId kRoot = 0;
+
+    explicit PortfolioTree(const std::string& rootName = "Total");
+
+    // Devuelve el hijo con ese nombre, creándolo si no existe
+    NodeId addNode(NodeId parent, const std::string& name);
+
+    const std::string& name(NodeId node) const { return nodes_.at(node).name; }
+    NodeId parent(NodeId node) const { return nodes_.at(node).parent; }
+    std::size_t depth(NodeId node) const { return nodes_.at(node).depth; }
+    std::size_t nodes() const { return nodes_.size(); }
+
+    TradeId addTrade(NodeId node, const InstrumentDescription& description);
+    void amendTrade(TradeId trade, const InstrumentDescription& description);
+    void cancelTrade(TradeId trade);
+
+    // Revalora los trades que dependen de la curva indicada
+    void curveUpdated(const ZeroCouponCurve& curve);
+    void curveUpdated(const CurveHandle& handle);
+    void curveUpdated(const CurveRegistry& registry, const std::string& curveName);
+
+    PortfolioValue total(NodeId node) const;
+    PortfolioValue tradeValue(TradeId trade) const { return trades_.at(trade).value; }
+    std::size_t trades(NodeId node) const { return nodes_.at(node).trades; }
+    std::size_t trades() const { return trades_.size(); }
+
+    // Número de valoraciones de trades hechas (para seguir el coste incremental)
+    std::size_t repricings() const { return repricings_; }
+
+private:
+    struct Node {
+        Node(std::string name, NodeId parent, std::size_t depth)
+            : name(std::move(name)), parent(parent), depth(depth) {}
+
+        std::string name;
+        NodeId parent;
+        std::size_t depth;
+        CompensatedSum pv;
+        CompensatedSum dv01;
+        std::size_t trades = 0;
+        std::unordered_map<std::string, NodeId> children;
+    };
+
+    // El tipo concreto y los ids de curva se resuelven una vez al dar de alta el
+    // trade: la revalorización no hace dynamic_cast ni búsquedas por nombre
+    struct Trade {
+        NodeId node;
+        InstrumentDescription description;
+        std::unique_ptr<Instrument> instrument;
+        const Bond* bond = nullptr;
+        const Swap* swap = nullptr;
+        CurveRegistry::CurveId discountId = 0;   // Solo con registro de curvas
+        CurveRegistry::CurveId forwardId = 0;
+        std::vector<const void*> curves;   // Claves de las curvas de las que depende
+        PortfolioValue value;
+    };
+
+    Trade makeTrade(NodeId node, const InstrumentDescription& description) const;
+    PortfolioValue value(const Trade& trade);
+    void propagate(NodeId node, const PortfolioValue& delta, long tradeCount);
+    // Claves de las que dependía el trade que no deben tocarse (las que ya estaban
+    // enlazadas antes de una modificación)
+    void link(TradeId id, Trade& trade, const std::vector<const void*>& keep = {});
+    void unlink(TradeId id, const std::vector<const void*>& curves,
+                const std::vector<const void*>& keep = {});
+    void revalue(const void* curveKey);
+
+    std::vector<Node> nodes_;
+    std::unordered_map<TradeId, Trade> trades_;
+    std::unordered_map<const void*, std::unordered_set<TradeId>> dependents_;
+    TradeId nextTrade_ = 1;
+    std::size_t repricings_ = 0;
+};
+
+#endif // PORTFOLIO_TREE_HPP
@@ -0,0 +1,27 @@
+#include "pricing_cache.hpp"
+
+double PricingCache::price(const Instrument& instrument) {
+    CurveStamp stamp = instrument.curveStamp();
+
+    auto it = entries_.find(instrument.instrumentId());
+    if (it != entries_.end() && it->second.stamp == stamp) {
+        ++hits_;
+        return it->second.price;
+    }
+
+    // Alguna curva cambió (o es la primera vez): recalcular y guardar
+    ++misses_;
+    double value = instrument.price();
+    entries_[instrument.instrumentId()] = Entry{stamp, value};
+    return value;
+}
+
+void PricingCache::invalidate(const Instrument& instrument) {
+    entries_.erase(instrument.instrumentId());
+}
+
+void PricingCache::clear() {
+    entries_.clear();
+    hits_ = 0;
+    misses_ = 0;
+}
@@ -0,0 +1,36 @@
+#ifndef PRICING_CACHE_HPP
+#define PRICING_CACHE_HPP
+
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+#include "instrument.hpp"
+
+// Memoiza el último precio de cada instrumento junto con la firma de versiones
+// de sus curvas. Mientras ninguna curva se republique, price() no recalcula.
+// Las entradas se indexan por Instrument::instrumentId(), así que un
+// instrumento nuevo nunca hereda el precio de otro destruido en la misma
+// dirección. Si un trade se modifica en sitio hay que llamar a invalidate().
+class PricingCache {
+public:
+    double price(const Instrument& instrument);
+
+    void invalidate(const Instrument& instrument);
+    void clear();
+
+    std::size_t size() const { return entries_.size(); }
+    std::size_t hits() const { return hits_; }
+    std::size_t misses() const { return misses_; }
+
+private:
+    struct Entry {
+        CurveStamp stamp;
+        double price;
+    };
+
+    std::unordered_map<std::uint64_t, Entry> entries_;
+    std::size_t hits_ = 0;
+    std::size_t misses_ = 0;
+};
+
+#endif // PRICING_CACHE_HPP
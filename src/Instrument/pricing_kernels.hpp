@@ -0,0 +1,69 @@
+#ifndef PRICING_KERNELS_HPP
+#define PRICING_KERNELS_HPP
+
+#include <vector>
+#include <cstddef>
+#include "discount_curve.hpp"
+
+// Kernels de descuento genéricos sobre cualquier curva (ver discount_curve.hpp).
+
+// Σ amounts_i * DF(times_i) sobre columnas contiguas
+template<typename Curve>
+inline double discountedSum(const Curve& curve, const double* times,
+                            const double* amounts, std::size_t n) {
+    double pv = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        pv += amounts[i] * curve.getDiscountFactor(times[i]);
+    }
+    return pv;
+}
+
+template<typename Curve>
+inline double discountedSum(const Curve& curve, const std::vector<double>& times,
+                            const std::vector<double>& amounts) {
+    return discountedSum(curve, times.data(), amounts.data(), times.size());
+}
+
+// Momentos de los flujos descontados: Σ PV_i, Σ t_i PV_i y Σ t_i² PV_i
+struct DiscountedMoments {
+    double pv = 0.0;
+    double first = 0.0;
+    double second = 0.0;
+};
+
+template<typename Curve>
+inline DiscountedMoments discountedMoments(const Curve& curve, const std::vector<double>& times,
+                                           const std::vector<double>& amounts) {
+    DiscountedMoments moments;
+    for (std::size_t i = 0; i < times.size(); ++i) {
+        double t = times[i];
+        double discounted = amounts[i] * curve.getDiscountFactor(t);
+        moments.pv += discounted;
+        moments.first += t * discounted;
+        moments.second += t * t * discounted;
+    }
+    return moments;
+}
+
+// Valor a un horizonte h: los flujos con t <= h ya se han pagado (paid, sin
+// descontar) y el resto se descuenta con la curva vista desde h, en t - h.
+struct HorizonValue {
+    double pv = 0.0;
+    double paid = 0.0;
+};
+
+template<typename Curve>
+inline HorizonValue discountedSumAt(const Curve& curve, const std::vector<double>& times,
+                                    const std::vector<double>& amounts, double horizon) {
+    HorizonValue value;
+    for (std::size_t i = 0; i < times.size(); ++i) {
+        if (times[i] <= horizon) {
+            value.paid += amounts[i];
+        } else {
+            value.pv += amounts[i] * curve.getDiscountFactor(times[i] - horizon);
+        }
+    }
+    return value;
+}
+
+#endif // PRICING_KERNELS_HPP
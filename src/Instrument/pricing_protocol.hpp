@@ -0,0 +1,49 @@
+#ifndef PRICING_PROTOCOL_HPP
+#define PRICING_PROTOCOL_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+/* Protocolo binario del servidor de precios (PricingServer / PricingClient).
+ *
+ * Solo para uso local sobre socket Unix: los campos van en el orden de bytes
+ * de la máquina y sin relleno entre mensajes.
+ *  Petición:  RequestHeader + count * uint32 (identificadores de trade)
+ *  Respuesta: ResponseHeader + count * TradeResult (0 si status != Ok)
+ * Las respuestas de una conexión llegan en el orden de sus peticiones.
+ */
+namespace protocol {
+
+enum class Operation : std::uint16_t {
+    Price = 1,   // Solo valor (dv01 = 0)
+    Risk = 2     // Valor y dv01
+};
+
+enum class Status : std::uint16_t {
+    Ok = 0,
+    UnknownTrade = 1,
+    BadRequest = 2
+};
+
+struct RequestHeader {
+    std::uint32_t requestId;
+    std::uint16_t operation;
+    std::uint16_t count;
+};
+
+struct ResponseHeader {
+    std::uint32_t requestId;
+    std::uint16_t status;
+    std::uint16_t count;
+};
+
+struct TradeResult {
+    double value;   // Precio del bono o NPV del swap
+    double dv01;    // Cambio de valor por -1pb de la curva
+};
+
+const std::size_t kMaxTradesPerRequest = 4096;
+
+} // namespace protocol
+
+#endif // PRICING_PROTOCOL_HPP
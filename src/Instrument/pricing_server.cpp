@@ -0,0 +1,402 @@
+#include "pricing_server.hpp"
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+const int kMaxEvents = 64;
+const std::size_t kReadChunk = 64 * 1024;
+
+std::runtime_error systemError(const std::string& what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+sockaddr_un socketAddress(const std::string& path) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw std::invalid_argument("Ruta de socket demasiado larga: " + path);
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return address;
+}
+
+void setNonBlocking(int fd) {
+    int flags = ::fcntl(fd, F_GETFL, 0);
+    if (flags < 0 || ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+        throw systemError("No se pudo configurar el socket");
+    }
+}
+
+template<typename T>
+void append(std::vector<char>& out, const T& value) {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+} // namespace
+
+PricingServer::PricingServer(std::string socketPath, std::shared_ptr<CurveHandle> curve)
+    : socketPath_(std::move(socketPath)), curve_(std::move(curve)) {
+    if (!curve_) {
+        throw std::invalid_argument("PricingServer necesita una curva");
+    }
+}
+
+PricingServer::~PricingServer() {
+    stop();
+}
+
+PricingServer::TradeId PricingServer::add(std::unique_ptr<Instrument> instrument) {
+    if (running_) {
+        throw std::logic_error("No se pueden añadir trades con el servidor en marcha");
+    }
+    Trade trade{std::move(instrument), nullptr, nullptr};
+    trade.bond = dynamic_cast<const Bond*>(trade.instrument.get());
+    trade.swap = dynamic_cast<const Swap*>(trade.instrument.get());
+    if (!trade.bond && !trade.swap) {
+        throw std::invalid_argument("PricingServer solo admite bonos y swaps");
+    }
+    trades_.push_back(std::move(trade));
+    return static_cast<TradeId>(trades_.size() - 1);
+}
+
+void PricingServer::start() {
+    if (running_) return;
+
+    sockaddr_un address = socketAddress(socketPath_);
+    ::unlink(socketPath_.c_str());
+
+    // Ante cualquier error se cierran los descriptores ya abiertos
+    try {
+        listenFd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listenFd_ < 0) throw systemError("No se pudo crear el socket");
+        if (::bind(listenFd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+            ::listen(listenFd_, SOMAXCONN) < 0) {
+            throw systemError("No se pudo escuchar en " + socketPath_);
+        }
+        setNonBlocking(listenFd_);
+
+        epollFd_ = ::epoll_create1(0);
+        if (epollFd_ < 0) throw systemError("No se pudo crear el bucle de eventos");
+        wakeFd_ = ::eventfd(0, EFD_NONBLOCK);
+        if (wakeFd_ < 0) throw systemError("No se pudo crear el bucle de eventos");
+
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = listenFd_;
+        if (::epoll_ctl(epollFd_, EPOLL_CTL_ADD, listenFd_, &event) < 0) {
+            throw systemError("No se pudo registrar el socket de escucha");
+        }
+        event.data.fd = wakeFd_;
+        if (::epoll_ctl(epollFd_, EPOLL_CTL_ADD, wakeFd_, &event) < 0) {
+            throw systemError("No se pudo registrar el aviso de parada");
+        }
+
+        memo_.resize(trades_.size());
+        memoBatch_.assign(trades_.size(), 0);
+
+        thread_ = std::thread(&PricingServer::run, this);
+    } catch (...) {
+        closeDescriptors();
+        throw;
+    }
+    running_ = true;
+}
+
+void PricingServer::stop() {
+    if (!running_) return;
+
+    std::uint64_t one = 1;
+    if (::write(wakeFd_, &one, sizeof(one)) < 0) {
+        // El bucle se despierta igualmente si ya había una señal pendiente
+    }
+    thread_.join();
+    running_ = false;
+
+    for (auto& entry : connections_) ::close(entry.first);
+    connections_.clear();
+    closeDescriptors();
+}
+
+void PricingServer::closeDescriptors() {
+    for (int* fd : {&listenFd_, &epollFd_, &wakeFd_}) {
+        if (*fd >= 0) ::close(*fd);
+        *fd = -1;
+    }
+    ::unlink(socketPath_.c_str());
+}
+
+void PricingServer::run() {
+    epoll_event events[kMaxEvents];
+    for (;;) {
+        int n = ::epoll_wait(epollFd_, events, kMaxEvents, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+
+        for (int i = 0; i < n; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == wakeFd_) return;
+            if (fd == listenFd_) {
+                accept();
+                continue;
+            }
+            auto it = connections_.find(fd);
+            if (it == connections_.end()) continue;
+            Connection& connection = *it->second;
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) connection.closed = true;
+            if (events[i].events & EPOLLIN) read(connection);
+            if (events[i].events & EPOLLOUT) flush(connection);
+        }
+
+        // Todas las peticiones de esta vuelta forman un lote
+        if (!pending_.empty()) processBatch();
+
+        for (auto it = connections_.begin(); it != connections_.end();) {
+            Connection& connection = *it->second;
+            if (connection.written < connection.output.size()) flush(connection);
+            if (connection.closed) {
+                ::close(connection.fd);
+                it = connections_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+void PricingServer::accept() {
+    for (;;) {
+        int fd = ::accept(listenFd_, nullptr, nullptr);
+        if (fd < 0) return;   // EAGAIN: no quedan conexiones pendientes
+
+        // Una conexión que no se puede configurar se descarta sin parar el bucle
+        int flags = ::fcntl(fd, F_GETFL, 0);
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        if (flags < 0 || ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0 ||
+            ::epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+            ::close(fd);
+            continue;
+        }
+
+        auto connection = std::make_unique<Connection>();
+        connection->fd = fd;
+        connections_[fd] = std::move(connection);
+    }
+}
+
+void PricingServer::read(Connection& connection) {
+    for (;;) {
+        std::size_t used = connection.input.size();
+        connection.input.resize(used + kReadChunk);
+        ssize_t n = ::recv(connection.fd, connection.input.data() + used, kReadChunk, 0);
+        connection.input.resize(used + (n > 0 ? n : 0));
+        if (n > 0) continue;
+        if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+            connection.closed = true;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        break;
+    }
+    parse(connection);
+}
+
+void PricingServer::parse(Connection& connection) {
+    using protocol::RequestHeader;
+
+    std::size_t offset = 0;
+    const std::vector<char>& input = connection.input;
+    while (input.size() - offset >= sizeof(RequestHeader)) {
+        RequestHeader header;
+        std::memcpy(&header, input.data() + offset, sizeof(header));
+        std::size_t frame = sizeof(header) + header.count * sizeof(TradeId);
+        if (input.size() - offset < frame) break;
+
+        Pending request{&connection, header, pendingIds_.size()};
+        const char* ids = input.data() + offset + sizeof(header);
+        for (std::size_t i = 0; i < header.count; ++i) {
+            TradeId id;
+            std::memcpy(&id, ids + i * sizeof(TradeId), sizeof(id));
+            pendingIds_.push_back(id);
+        }
+        pending_.push_back(request);
+        offset += frame;
+    }
+    connection.input.erase(connection.input.begin(), connection.input.begin() + offset);
+}
+
+protocol::TradeResult PricingServer::evaluate(TradeId id, const ZeroCouponCurve& curve) {
+    if (memoBatch_[id] != batch_) {
+        // Valor y dv01 salen de la misma pasada sobre los flujos
+        const Trade& trade = trades_[id];
+        if (trade.bond) {
+            BondRisk risk = trade.bond->risk(curve);
+            memo_[id] = {risk.price, risk.dv01};
+        } else {
+            SwapRisk risk = trade.swap->risk(curve);
+            memo_[id] = {risk.npv, risk.dv01};
+        }
+        memoBatch_[id] = batch_;
+    }
+    return memo_[id];
+}
+
+void PricingServer::processBatch() {
+    using namespace protocol;
+
+    ++batch_;
+    CurveHandle::ReadGuard guard(*curve_);
+    const ZeroCouponCurve& curve = guard.curve();
+
+    for (const Pending& request : pending_) {
+        Connection& connection = *request.connection;
+        const TradeId* ids = pendingIds_.data() + request.idsOffset;
+        std::uint16_t count = request.header.count;
+
+        Status status = Status::Ok;
+        Operation operation = static_cast<Operation>(request.header.operation);
+        if ((operation != Operation::Price && operation != Operation::Risk) ||
+            count > kMaxTradesPerRequest) {
+            status = Status::BadRequest;
+        }
+        for (std::size_t i = 0; status == Status::Ok && i < count; ++i) {
+            if (ids[i] >= trades_.size()) status = Status::UnknownTrade;
+        }
+
+        ResponseHeader response{request.header.requestId, static_cast<std::uint16_t>(status),
+                                static_cast<std::uint16_t>(status == Status::Ok ? count : 0)};
+        append(connection.output, response);
+        for (std::size_t i = 0; i < response.count; ++i) {
+            TradeResult result = evaluate(ids[i], curve);
+            if (operation == Operation::Price) result.dv01 = 0.0;
+            append(connection.output, result);
+        }
+    }
+
+    requests_.fetch_add(pending_.size(), std::memory_order_relaxed);
+    batches_.fetch_add(1, std::memory_order_relaxed);
+    pending_.clear();
+    pendingIds_.clear();
+}
+
+void PricingServer::flush(Connection& connection) {
+    while (connection.written < connection.output.size()) {
+        ssize_t n = ::send(connection.fd, connection.output.data() + connection.written,
+                           connection.output.size() - connection.written, MSG_NOSIGNAL);
+        if (n > 0) {
+            connection.written += n;
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        connection.closed = true;
+        return;
+    }
+
+    bool pendingOutput = connection.written < connection.output.size();
+    if (!pendingOutput) {
+        connection.output.clear();
+        connection.written = 0;
+    }
+    // Solo se pide EPOLLOUT mientras queden datos por enviar
+    if (pendingOutput != connection.writable) {
+        epoll_event event{};
+        event.events = EPOLLIN | (pendingOutput ? static_cast<std::uint32_t>(EPOLLOUT) : 0u);
+        event.data.fd = connection.fd;
+        if (::epoll_ctl(epollFd_, EPOLL_CTL_MOD, connection.fd, &event) < 0) {
+            // Sin EPOLLOUT la respuesta pendiente no se enviaría nunca
+            connection.closed = true;
+            return;
+        }
+        connection.writable = pendingOutput;
+    }
+}
+
+PricingClient::PricingClient(const std::string& socketPath) {
+    sockaddr_un address = socketAddress(socketPath);
+    fd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd_ < 0) throw systemError("No se pudo crear el socket");
+    if (::connect(fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        ::close(fd_);
+        throw systemError("No se pudo conectar a " + socketPath);
+    }
+}
+
+PricingClient::~PricingClient() {
+    if (fd_ >= 0) ::close(fd_);
+}
+
+void PricingClient::request(protocol::Operation operation, const std::vector<std::uint32_t>& ids,
+                            std::vector<protocol::TradeResult>& results) {
+    using namespace protocol;
+
+    if (ids.size() > kMaxTradesPerRequest) {
+        throw std::invalid_argument("Demasiados trades en una petición");
+    }
+    RequestHeader header{nextRequestId_++, static_cast<std::uint16_t>(operation),
+                         static_cast<std::uint16_t>(ids.size())};
+    buffer_.clear();
+    append(buffer_, header);
+    const char* bytes = reinterpret_cast<const char*>(ids.data());
+    buffer_.insert(buffer_.end(), bytes, bytes + ids.size() * sizeof(std::uint32_t));
+    writeAll(buffer_.data(), buffer_.size());
+
+    ResponseHeader response;
+    readAll(&response, sizeof(response));
+    if (response.requestId != header.requestId) {
+        throw std::runtime_error("Respuesta fuera de orden del servidor de precios");
+    }
+    if (static_cast<Status>(response.status) != Status::Ok) {
+        throw std::runtime_error("El servidor de precios rechazó la petición (estado "
+                                 + std::to_string(response.status) + ")");
+    }
+    results.resize(response.count);
+    readAll(results.data(), response.count * sizeof(TradeResult));
+}
+
+std::vector<protocol::TradeResult> PricingClient::price(const std::vector<std::uint32_t>& ids) {
+    std::vector<protocol::TradeResult> results;
+    request(protocol::Operation::Price, ids, results);
+    return results;
+}
+
+std::vector<protocol::TradeResult> PricingClient::risk(const std::vector<std::uint32_t>& ids) {
+    std::vector<protocol::TradeResult> results;
+    request(protocol::Operation::Risk, ids, results);
+    return results;
+}
+
+void PricingClient::writeAll(const void* data, std::size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t n = ::send(fd_, bytes, size, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) throw systemError("Error enviando al servidor de precios");
+        bytes += n;
+        size -= n;
+    }
+}
+
+void PricingClient::readAll(void* data, std::size_t size) {
+    char* bytes = static_cast<char*>(data);
+    while (size > 0) {
+        ssize_t n = ::recv(fd_, bytes, size, 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n == 0) throw std::runtime_error("El servidor de precios cerró la conexión");
+        if (n < 0) throw systemError("Error leyendo del servidor de precios");
+        bytes += n;
+        size -= n;
+    }
+}
@@ -0,0 +1,127 @@
+#ifndef PRICING_SERVER_HPP
+#define PRICING_SERVER_HPP
+
+#include "pricing_protocol.hpp"
+#include "curve_handle.hpp"
+#include "bond.hpp"
+#include "swap.hpp"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/* Servidor de precios sobre socket Unix (ver pricing_protocol.hpp).
+ *
+ * Un único hilo atiende todas las conexiones con epoll y sockets no
+ * bloqueantes. En cada vuelta del bucle se leen todas las peticiones
+ * completas de los clientes listos y se valoran en un solo lote: una lectura
+ * de la curva (ReadGuard) para todo el lote y cada trade se valora una sola
+ * vez aunque lo pidan varias peticiones. La curva puede republicarse en
+ * caliente a través del CurveHandle.
+ *
+ * Los instrumentos se añaden antes de start(); su identificador es el orden
+ * de alta.
+ */
+class PricingServer {
+public:
+    using TradeId = std::uint32_t;
+
+    PricingServer(std::string socketPath, std::shared_ptr<CurveHandle> curve);
+    ~PricingServer();
+
+    PricingServer(const PricingServer&) = delete;
+    PricingServer& operator=(const PricingServer&) = delete;
+
+    // Solo se admiten bonos y swaps
+    TradeId add(std::unique_ptr<Instrument> instrument);
+    std::size_t size() const { return trades_.size(); }
+
+    void start();
+    void stop();
+
+    const std::string& socketPath() const { return socketPath_; }
+    std::size_t requests() const { return requests_.load(std::memory_order_relaxed); }
+    std::size_t batches() const { return batches_.load(std::memory_order_relaxed); }
+
+private:
+    struct Trade {
+        std::unique_ptr<Instrument> instrument;
+        const Bond* bond;
+        const Swap* swap;
+    };
+
+    struct Connection {
+        int fd;
+        std::vector<char> input;
+        std::vector<char> output;
+        std::size_t written = 0;
+        bool writable = false;   // Registrado en EPOLLOUT
+        bool closed = false;
+    };
+
+    struct Pending {
+        Connection* connection;
+        protocol::RequestHeader header;
+        std::size_t idsOffset;   // Posición de los ids en pendingIds_
+    };
+
+    void closeDescriptors();
+    void run();
+    void accept();
+    void read(Connection& connection);
+    void parse(Connection& connection);
+    void processBatch();
+    void flush(Connection& connection);
+    protocol::TradeResult evaluate(TradeId id, const ZeroCouponCurve& curve);
+
+    std::string socketPath_;
+    std::shared_ptr<CurveHandle> curve_;
+    std::vector<Trade> trades_;
+
+    int listenFd_ = -1;
+    int epollFd_ = -1;
+    int wakeFd_ = -1;
+    std::thread thread_;
+    bool running_ = false;
+
+    std::unordered_map<int, std::unique_ptr<Connection>> connections_;
+    std::vector<Pending> pending_;
+    std::vector<TradeId> pendingIds_;
+
+    // Resultado de cada trade en el lote actual
+    std::vector<protocol::TradeResult> memo_;
+    std::vector<std::uint64_t> memoBatch_;
+    std::uint64_t batch_ = 0;
+
+    std::atomic<std::size_t> requests_{0};
+    std::atomic<std::size_t> batches_{0};
+};
+
+// Cliente síncrono: una petición cada vez por conexión
+class PricingClient {
+public:
+    explicit PricingClient(const std::string& socketPath);
+    ~PricingClient();
+
+    PricingClient(const PricingClient&) = delete;
+    PricingClient& operator=(const PricingClient&) = delete;
+
+    // Rellena results (mismo orden que ids); lanza si el servidor rechaza la petición
+    void request(protocol::Operation operation, const std::vector<std::uint32_t>& ids,
+                 std::vector<protocol::TradeResult>& results);
+
+    std::vector<protocol::TradeResult> price(const std::vector<std::uint32_t>& ids);
+    std::vector<protocol::TradeResult> risk(const std::vector<std::uint32_t>& ids);
+
+private:
+    void writeAll(const void* data, std::size_t size);
+    void readAll(void* data, std::size_t size);
+
+    int fd_ = -1;
+    std::uint32_t nextRequestId_ = 1;
+    std::vector<char> buffer_;
+};
+
+#endif // PRICING_SERVER_HPP
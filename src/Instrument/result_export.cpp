@@ -0,0 +1,416 @@
+#include "result_export.hpp"
+#include <charconv>
+#include <stdexcept>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+const char kMagic[4] = {'Z', 'C', 'R', 'T'};
+const std::uint32_t kFormatVersion = 1;
+
+// Cabecera del fichero (16 bytes)
+struct Header {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t columns;
+    std::uint32_t chunkRows;
+};
+
+// Pie del fichero (32 bytes), al final para poder escribir en streaming
+struct Footer {
+    std::uint64_t chunks;
+    std::uint64_t rows;
+    std::uint64_t indexOffset;
+    char magic[4];
+    std::uint32_t reserved;
+};
+
+std::size_t alignTo8(std::size_t n) { return (n + 7) & ~static_cast<std::size_t>(7); }
+
+const char kPadding[8] = {0};
+
+} // namespace
+
+std::size_t columnWidth(ColumnType type) {
+    switch (type) {
+        case ColumnType::UInt64: return sizeof(std::uint64_t);
+        case ColumnType::Float64: return sizeof(double);
+        case ColumnType::UInt8: return sizeof(std::uint8_t);
+    }
+    throw std::invalid_argument("Tipo de columna desconocido");
+}
+
+ColumnChunk::ColumnChunk(const std::vector<ColumnSpec>& schema, std::size_t capacity)
+    : capacity_(capacity) {
+    // Inicializadas a cero: las páginas quedan tocadas antes de empezar a exportar
+    for (const auto& spec : schema) {
+        columns_.emplace_back(new unsigned char[alignTo8(capacity * columnWidth(spec.type))]());
+    }
+}
+
+// ---------------------------------------------------------------------------
+// ColumnarWriter
+// ---------------------------------------------------------------------------
+
+ColumnarWriter::ColumnarWriter(const std::string& path, std::vector<ColumnSpec> schema, ExportFormat format,
+                               std::size_t chunkRows, std::size_t chunks)
+    : path_(path), schema_(std::move(schema)), format_(format), chunkRows_(chunkRows) {
+    if (schema_.empty() || chunkRows == 0 || chunks == 0)
+        throw std::invalid_argument("Esquema o bloques vacíos en la exportación");
+    for (const auto& spec : schema_) {
+        if (spec.name.empty() || spec.name.size() > 255)
+            throw std::invalid_argument("Nombre de columna inválido: " + spec.name);
+        columnWidth(spec.type);
+    }
+
+    output_.open(path, std::ios::binary);
+    if (!output_) throw std::runtime_error("No se pudo escribir el informe: " + path);
+    writeHeader();
+
+    for (std::size_t i = 0; i < chunks; ++i) {
+        chunks_.push_back(std::make_unique<ColumnChunk>(schema_, chunkRows));
+        free_.push_back(chunks_.back().get());
+    }
+    thread_ = std::thread([this] { run(); });
+}
+
+ColumnarWriter::~ColumnarWriter() {
+    try {
+        close();
+    } catch (...) {
+        // Un destructor no lanza; quien necesite el error debe llamar a close()
+    }
+}
+
+void ColumnarWriter::rethrowIfFailed() {
+    if (error_) std::rethrow_exception(error_);
+}
+
+ColumnChunk& ColumnarWriter::acquire() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    released_.wait(lock, [this] { return !free_.empty() || error_; });
+    rethrowIfFailed();
+    ColumnChunk* chunk = free_.back();
+    free_.pop_back();
+    chunk->clear();
+    return *chunk;
+}
+
+void ColumnarWriter::submit(ColumnChunk& chunk) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // El bloque vuelve al escritor aunque haya fallado, para que no se pierda
+        pending_.push_back(&chunk);
+        rows_ += chunk.size();
+    }
+    ready_.notify_one();
+    std::lock_guard<std::mutex> lock(mutex_);
+    rethrowIfFailed();
+}
+
+void ColumnarWriter::close() {
+    if (closed_) return;
+    closed_ = true;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closing_ = true;
+    }
+    ready_.notify_one();
+    thread_.join();
+
+    if (!error_) {
+        try {
+            if (format_ == ExportFormat::Columnar) writeFooter();
+            output_.close();
+            if (!output_) throw std::runtime_error("No se pudo escribir el informe: " + path_);
+        } catch (...) {
+            error_ = std::current_exception();
+        }
+    }
+    rethrowIfFailed();
+}
+
+void ColumnarWriter::run() {
+    for (;;) {
+        ColumnChunk* chunk;
+        bool failed;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ready_.wait(lock, [this] { return !pending_.empty() || closing_; });
+            if (pending_.empty()) return;
+            chunk = pending_.front();
+            pending_.pop_front();
+            failed = static_cast<bool>(error_);
+        }
+
+        if (!failed && chunk->size() > 0) {
+            try {
+                if (format_ == ExportFormat::Columnar) writeChunk(*chunk);
+                else writeCsv(*chunk);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                error_ = std::current_exception();
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            free_.push_back(chunk);
+        }
+        released_.notify_one();
+    }
+}
+
+void ColumnarWriter::write(const void* data, std::size_t bytes) {
+    output_.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+    if (!output_) throw std::runtime_error("No se pudo escribir el informe: " + path_);
+    offset_ += bytes;
+}
+
+void ColumnarWriter::writeHeader() {
+    if (format_ == ExportFormat::Csv) {
+        std::string line;
+        for (std::size_t c = 0; c < schema_.size(); ++c) {
+            if (c > 0) line += ',';
+            line += schema_[c].name;
+        }
+        line += '\n';
+        write(line.data(), line.size());
+        return;
+    }
+
+    Header header;
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kFormatVersion;
+    header.columns = static_cast<std::uint32_t>(schema_.size());
+    header.chunkRows = static_cast<std::uint32_t>(chunkRows_);
+    write(&header, sizeof(header));
+
+    std::vector<char> entries;
+    for (const auto& spec : schema_) {
+        entries.push_back(static_cast<char>(spec.type));
+        entries.push_back(static_cast<char>(static_cast<unsigned char>(spec.name.size())));
+        entries.insert(entries.end(), spec.name.begin(), spec.name.end());
+    }
+    write(entries.data(), entries.size());
+    write(kPadding, alignTo8(entries.size()) - entries.size());
+}
+
+void ColumnarWriter::writeChunk(const ColumnChunk& chunk) {
+    chunkOffsets_.push_back(offset_);
+    std::uint64_t rows = chunk.size();
+    write(&rows, sizeof(rows));
+    for (std::size_t c = 0; c < schema_.size(); ++c) {
+        std::size_t bytes = chunk.size() * columnWidth(schema_[c].type);
+        write(chunk.column<unsigned char>(c), bytes);
+        write(kPadding, alignTo8(bytes) - bytes);
+    }
+    writtenRows_ += rows;
+}
+
+void ColumnarWriter::writeCsv(const ColumnChunk& chunk) {
+    // Texto de todo el bloque en un buffer reutilizado y una sola escritura.
+    // to_chars da la representación más corta que se relee al mismo double.
+    text_.clear();
+    char field[32];
+    for (std::size_t row = 0; row < chunk.size(); ++row) {
+        for (std::size_t c = 0; c < schema_.size(); ++c) {
+            std::to_chars_result result;
+            switch (schema_[c].type) {
+                case ColumnType::UInt64:
+                    result = std::to_chars(field, field + sizeof(field), chunk.column<std::uint64_t>(c)[row]);
+                    break;
+                case ColumnType::Float64:
+                    result = std::to_chars(field, field + sizeof(field), chunk.column<double>(c)[row]);
+                    break;
+                default:
+                    result = std::to_chars(field, field + sizeof(field),
+                                           static_cast<unsigned>(chunk.column<std::uint8_t>(c)[row]));
+                    break;
+            }
+            if (c > 0) text_ += ',';
+            text_.append(field, result.ptr);
+        }
+        text_ += '\n';
+    }
+    write(text_.data(), text_.size());
+    writtenRows_ += chunk.size();
+}
+
+void ColumnarWriter::writeFooter() {
+    Footer footer;
+    footer.chunks = chunkOffsets_.size();
+    footer.rows = writtenRows_;
+    footer.indexOffset = offset_;
+    std::memcpy(footer.magic, kMagic, sizeof(kMagic));
+    footer.reserved = 0;
+    write(chunkOffsets_.data(), chunkOffsets_.size() * sizeof(std::uint64_t));
+    write(&footer, sizeof(footer));
+}
+
+// ---------------------------------------------------------------------------
+// Tablas
+// ---------------------------------------------------------------------------
+
+TableExporter::TableExporter(const std::string& path, const std::vector<ColumnSpec>& schema,
+                             ExportFormat format, std::size_t chunkRows)
+    : writer_(path, schema, format, chunkRows) {}
+
+TableExporter::~TableExporter() {
+    try {
+        close();
+    } catch (...) {
+    }
+}
+
+void TableExporter::rotate() {
+    ColumnChunk* full = chunk_;
+    chunk_ = nullptr;
+    if (full) writer_.submit(*full);
+    chunk_ = &writer_.acquire();
+}
+
+void TableExporter::close() {
+    if (closed_) return;
+    closed_ = true;
+    if (chunk_) {
+        ColumnChunk* last = chunk_;
+        chunk_ = nullptr;
+        writer_.submit(*last);
+    }
+    writer_.close();
+}
+
+const std::vector<ColumnSpec>& CashflowExporter::schema() {
+    static const std::vector<ColumnSpec> columns = {
+        {"trade_id", ColumnType::UInt64},
+        {"leg", ColumnType::UInt8},
+        {"time", ColumnType::Float64},
+        {"amount", ColumnType::Float64},
+        {"discount_factor", ColumnType::Float64},
+        {"present_value", ColumnType::Float64},
+        {"notional", ColumnType::Float64},
+        {"accrual", ColumnType::Float64},
+        {"rate", ColumnType::Float64},
+        {"fixing_start", ColumnType::Float64},
+        {"fixing_end", ColumnType::Float64},
+        {"projected", ColumnType::UInt8}};
+    return columns;
+}
+
+const std::vector<ColumnSpec>& TradeResultExporter::schema() {
+    static const std::vector<ColumnSpec> columns = {
+        {"trade_id", ColumnType::UInt64},
+        {"present_value", ColumnType::Float64},
+        {"dv01", ColumnType::Float64}};
+    return columns;
+}
+
+// ---------------------------------------------------------------------------
+// ColumnarReader
+// ---------------------------------------------------------------------------
+
+ColumnarReader::ColumnarReader(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("No se pudo abrir el informe: " + path);
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(Header) + sizeof(Footer)) {
+        ::close(fd);
+        throw std::runtime_error("Fichero de informe inválido: " + path);
+    }
+    mappedSize_ = static_cast<std::size_t>(info.st_size);
+    mapped_ = ::mmap(nullptr, mappedSize_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapped_ == MAP_FAILED) {
+        mapped_ = nullptr;
+        throw std::runtime_error("No se pudo mapear el informe: " + path);
+    }
+
+    const auto* bytes = static_cast<const unsigned char*>(mapped_);
+    Header header;
+    Footer footer;
+    std::memcpy(&header, bytes, sizeof(header));
+    std::memcpy(&footer, bytes + mappedSize_ - sizeof(footer), sizeof(footer));
+    auto reject = [this, &path]() {
+        ::munmap(mapped_, mappedSize_);
+        mapped_ = nullptr;
+        throw std::runtime_error("Formato de informe no soportado: " + path);
+    };
+    // Los campos del pie se comprueban sin desbordar antes de usarlos como tamaños
+    const std::size_t indexEnd = mappedSize_ - sizeof(Footer);
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kFormatVersion
+        || std::memcmp(footer.magic, kMagic, sizeof(kMagic)) != 0
+        || footer.indexOffset > indexEnd || footer.indexOffset % 8 != 0
+        || footer.chunks != (indexEnd - footer.indexOffset) / sizeof(std::uint64_t)
+        || (indexEnd - footer.indexOffset) % sizeof(std::uint64_t) != 0) {
+        reject();
+    }
+
+    std::size_t position = sizeof(Header);
+    for (std::uint32_t c = 0; c < header.columns; ++c) {
+        if (position + 2 > footer.indexOffset) reject();
+        ColumnType type = static_cast<ColumnType>(bytes[position]);
+        std::size_t length = bytes[position + 1];
+        position += 2;
+        if (position + length > footer.indexOffset) reject();
+        schema_.push_back({std::string(reinterpret_cast<const char*>(bytes + position), length), type});
+        position += length;
+        try {
+            columnWidth(type);
+        } catch (const std::invalid_argument&) {
+            reject();
+        }
+    }
+
+    // Cada bloque debe caber antes del índice (rows * width no puede desbordar) y
+    // la suma de filas de los bloques debe coincidir con el pie, que es lo que
+    // column() reserva
+    const auto* offsets = reinterpret_cast<const std::uint64_t*>(bytes + footer.indexOffset);
+    std::uint64_t totalRows = 0;
+    chunkRows_.reserve(footer.chunks);
+    columnOffsets_.reserve(footer.chunks * schema_.size());
+    for (std::size_t k = 0; k < footer.chunks; ++k) {
+        std::uint64_t offset = offsets[k];
+        if (offset % 8 != 0 || offset >= footer.indexOffset
+            || footer.indexOffset - offset < sizeof(std::uint64_t)) {
+            reject();
+        }
+        std::uint64_t rows;
+        std::memcpy(&rows, bytes + offset, sizeof(rows));
+        offset += sizeof(std::uint64_t);
+        if (rows > footer.rows - totalRows) reject();
+        totalRows += rows;
+        chunkRows_.push_back(rows);
+        for (const auto& spec : schema_) {
+            std::size_t width = columnWidth(spec.type);
+            if (rows > (footer.indexOffset - offset) / width) reject();
+            columnOffsets_.push_back(offset);
+            offset += alignTo8(rows * width);
+            if (offset > footer.indexOffset) reject();
+        }
+    }
+    if (totalRows != footer.rows) reject();
+    rows_ = footer.rows;
+}
+
+ColumnarReader::~ColumnarReader() {
+    if (mapped_) ::munmap(mapped_, mappedSize_);
+}
+
+std::size_t ColumnarReader::columnIndex(const std::string& name) const {
+    for (std::size_t c = 0; c < schema_.size(); ++c) {
+        if (schema_[c].name == name) return c;
+    }
+    throw std::invalid_argument("Columna inexistente en el informe: " + name);
+}
+
+const unsigned char* ColumnarReader::columnData(std::size_t chunk, std::size_t column, std::size_t width) const {
+    if (width != columnWidth(schema_.at(column).type))
+        throw std::invalid_argument("Tipo incompatible con la columna " + schema_[column].name);
+    return static_cast<const unsigned char*>(mapped_) + columnOffsets_.at(chunk * schema_.size() + column);
+}
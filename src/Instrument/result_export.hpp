@@ -0,0 +1,303 @@
+#ifndef RESULT_EXPORT_HPP
+#define RESULT_EXPORT_HPP
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <fstream>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include "cashflow.hpp"
+
+/*
+ * Exportación columnar de resultados
+ * ==================================
+ * Tablas de flujos y de resultados por trade para herramientas externas, en
+ * formato binario columnar o en CSV. Las filas se escriben en bloques de
+ * columnas reservados de antemano; cuando un bloque se llena pasa a un hilo
+ * escritor y el productor sigue con el siguiente bloque libre. El pricing solo
+ * espera si el disco va más lento que él y todos los bloques están en cola.
+ *
+ * Formato binario (orden de bytes nativo del escritor, todo alineado a 8):
+ *   cabecera  magic 'ZCRT', versión, número de columnas, filas por bloque (16 bytes)
+ *   esquema   por columna: tipo (1 byte), longitud del nombre (1 byte) y nombre
+ *   bloques   filas del bloque (uint64) y cada columna como array nativo
+ *   índice    offset de cada bloque (uint64)
+ *   pie       bloques, filas totales, offset del índice y magic (32 bytes)
+ * Las columnas de un bloque se usan directamente desde el mmap, sin copiar
+ * ni descomprimir (ver ColumnarReader). Por eso no se convierte el orden de
+ * bytes: un fichero escrito con el orden contrario se rechaza al leer la
+ * versión de la cabecera.
+ */
+
+enum class ColumnType : std::uint8_t { UInt64 = 1, Float64 = 2, UInt8 = 3 };
+
+struct ColumnSpec {
+    std::string name;
+    ColumnType type;
+};
+
+enum class ExportFormat { Columnar, Csv };
+
+std::size_t columnWidth(ColumnType type);
+
+// Bloque de filas en columnas con capacidad fija, reservado una sola vez
+class ColumnChunk {
+public:
+    ColumnChunk(const std::vector<ColumnSpec>& schema, std::size_t capacity);
+
+    template<typename T>
+    T* column(std::size_t index) { return reinterpret_cast<T*>(columns_[index].get()); }
+    template<typename T>
+    const T* column(std::size_t index) const { return reinterpret_cast<const T*>(columns_[index].get()); }
+
+    std::size_t size() const { return size_; }
+    std::size_t capacity() const { return capacity_; }
+    std::size_t remaining() const { return capacity_ - size_; }
+    bool full() const { return size_ == capacity_; }
+
+    // Da por escritas las n filas siguientes a size()
+    void grow(std::size_t n) { size_ += n; }
+    void clear() { size_ = 0; }
+
+private:
+    std::vector<std::unique_ptr<unsigned char[]>> columns_;
+    std::size_t size_ = 0;
+    std::size_t capacity_;
+};
+
+/* Escritor de una tabla con hilo propio.
+ *
+ * acquire() entrega un bloque vacío (espera si todos están en cola) y submit()
+ * lo pasa al hilo escritor. close() vacía la cola, escribe el pie y relanza
+ * cualquier error de escritura; acquire() y submit() también lo relanzan en
+ * cuanto se produce. El fichero se abre en el constructor.
+ */
+class ColumnarWriter {
+public:
+    static constexpr std::size_t kDefaultChunkRows = 1 << 16;
+    static constexpr std::size_t kDefaultChunks = 4;
+
+    ColumnarWriter(const std::string& path, std::vector<ColumnSpec> schema, ExportFormat format,
+                   std::size_t chunkRows = kDefaultChunkRows, std::size_t chunks = kDefaultChunks);
+    ~ColumnarWriter();
+
+    ColumnarWriter(const ColumnarWriter&) = delete;
+    ColumnarWriter& operator=(const ColumnarWriter&) = delete;
+
+    ColumnChunk& acquire();
+    void submit(ColumnChunk& chunk);
+    void close();
+
+    const std::vector<ColumnSpec>& schema() const { return schema_; }
+    std::uint64_t rows() const { return rows_; }   // Filas entregadas con submit()
+
+private:
+    void run();
+    void writeHeader();
+    void writeChunk(const ColumnChunk& chunk);
+    void writeCsv(const ColumnChunk& chunk);
+    void writeFooter();
+    void write(const void* data, std::size_t bytes);
+    void rethrowIfFailed();
+
+    std::string path_;
+    std::vector<ColumnSpec> schema_;
+    ExportFormat format_;
+    std::size_t chunkRows_;
+    std::ofstream output_;
+
+    std::vector<std::unique_ptr<ColumnChunk>> chunks_;
+    std::vector<ColumnChunk*> free_;
+    std::deque<ColumnChunk*> pending_;
+    std::mutex mutex_;
+    std::condition_variable ready_;      // Hay bloques en cola o se cierra
+    std::condition_variable released_;   // Hay bloques libres o ha fallado la escritura
+    std::exception_ptr error_;
+    bool closing_ = false;
+    bool closed_ = false;
+    std::uint64_t rows_ = 0;
+
+    // Solo los usa el hilo escritor (y close() una vez terminado)
+    std::uint64_t offset_ = 0;
+    std::uint64_t writtenRows_ = 0;
+    std::vector<std::uint64_t> chunkOffsets_;
+    std::string text_;
+
+    std::thread thread_;
+};
+
+// Base de las tablas concretas: reparte las filas en los bloques del escritor
+class TableExporter {
+public:
+    TableExporter(const TableExporter&) = delete;
+    TableExporter& operator=(const TableExporter&) = delete;
+
+    // Entrega el bloque a medias y cierra el fichero
+    void close();
+    std::uint64_t rows() const { return writer_.rows() + (chunk_ ? chunk_->size() : 0); }
+
+protected:
+    TableExporter(const std::string& path, const std::vector<ColumnSpec>& schema,
+                  ExportFormat format, std::size_t chunkRows);
+    ~TableExporter();
+
+    // Bloque con hueco para al menos una fila
+    ColumnChunk& chunk() {
+        if (!chunk_ || chunk_->full()) rotate();
+        return *chunk_;
+    }
+
+private:
+    void rotate();
+
+    ColumnarWriter writer_;
+    ColumnChunk* chunk_ = nullptr;
+    bool closed_ = false;
+};
+
+/* Tabla de flujos: una fila por flujo con su DF y su PV contra la curva dada.
+ * leg vale 0 (fija), 1 (flotante) o 2 (principal), como CashflowLeg.
+ */
+class CashflowExporter : public TableExporter {
+public:
+    enum Column { TradeId, Leg, Time, Amount, DiscountFactor, PresentValue,
+                  Notional, Accrual, Rate, FixingStart, FixingEnd, Projected };
+
+    static const std::vector<ColumnSpec>& schema();
+
+    explicit CashflowExporter(const std::string& path, ExportFormat format = ExportFormat::Columnar,
+                              std::size_t chunkRows = ColumnarWriter::kDefaultChunkRows)
+        : TableExporter(path, schema(), format, chunkRows) {}
+
+    // Flujos [first, last) del buffer, p. ej. el rango de un trade
+    template<typename Curve>
+    void add(std::uint64_t tradeId, const Curve& curve, const CashflowBuffer& buffer,
+             std::size_t first, std::size_t last);
+
+    template<typename Curve>
+    void add(std::uint64_t tradeId, const Curve& curve, const CashflowBuffer& buffer) {
+        add(tradeId, curve, buffer, 0, buffer.size());
+    }
+};
+
+// Tabla de resultados por trade
+class TradeResultExporter : public TableExporter {
+public:
+    enum Column { TradeId, PresentValue, Dv01 };
+
+    static const std::vector<ColumnSpec>& schema();
+
+    explicit TradeResultExporter(const std::string& path, ExportFormat format = ExportFormat::Columnar,
+                                 std::size_t chunkRows = ColumnarWriter::kDefaultChunkRows)
+        : TableExporter(path, schema(), format, chunkRows) {}
+
+    void add(std::uint64_t tradeId, double pv, double dv01) {
+        ColumnChunk& c = chunk();
+        std::size_t row = c.size();
+        c.column<std::uint64_t>(TradeId)[row] = tradeId;
+        c.column<double>(PresentValue)[row] = pv;
+        c.column<double>(Dv01)[row] = dv01;
+        c.grow(1);
+    }
+};
+
+template<typename Curve>
+void CashflowExporter::add(std::uint64_t tradeId, const Curve& curve, const CashflowBuffer& buffer,
+                           std::size_t first, std::size_t last) {
+    while (first < last) {
+        ColumnChunk& c = chunk();
+        std::size_t n = std::min(last - first, c.remaining());
+        std::size_t row = c.size();
+
+        std::uint64_t* trade = c.column<std::uint64_t>(TradeId) + row;
+        std::uint8_t* leg = c.column<std::uint8_t>(Leg) + row;
+        std::uint8_t* projected = c.column<std::uint8_t>(Projected) + row;
+        double* time = c.column<double>(Time) + row;
+        double* amount = c.column<double>(Amount) + row;
+        double* df = c.column<double>(DiscountFactor) + row;
+        double* pv = c.column<double>(PresentValue) + row;
+        double* notional = c.column<double>(Notional) + row;
+        double* accrual = c.column<double>(Accrual) + row;
+        double* rate = c.column<double>(Rate) + row;
+        double* fixingStart = c.column<double>(FixingStart) + row;
+        double* fixingEnd = c.column<double>(FixingEnd) + row;
+
+        for (std::size_t i = 0; i < n; ++i) {
+            std::size_t k = first + i;
+            const CashflowInfo& info = buffer.info(k);
+            trade[i] = tradeId;
+            leg[i] = static_cast<std::uint8_t>(info.leg);
+            projected[i] = info.projected ? 1 : 0;
+            time[i] = buffer.time(k);
+            amount[i] = buffer.amount(k);
+            df[i] = curve.getDiscountFactor(time[i]);
+            pv[i] = amount[i] * df[i];
+            notional[i] = info.notional;
+            accrual[i] = info.accrual;
+            rate[i] = info.rate;
+            fixingStart[i] = info.fixingStart;
+            fixingEnd[i] = info.fixingEnd;
+        }
+        c.grow(n);
+        first += n;
+    }
+}
+
+/* Lectura de una tabla binaria con mmap.
+ *
+ * chunkColumn() da acceso directo a una columna de un bloque; column() copia
+ * la columna completa. Ambas comprueban que el ancho de T es el de la columna.
+ */
+class ColumnarReader {
+public:
+    explicit ColumnarReader(const std::string& path);
+    ~ColumnarReader();
+
+    ColumnarReader(const ColumnarReader&) = delete;
+    ColumnarReader& operator=(const ColumnarReader&) = delete;
+
+    const std::vector<ColumnSpec>& schema() const { return schema_; }
+    std::size_t rows() const { return rows_; }
+    std::size_t chunks() const { return chunkRows_.size(); }
+    std::size_t fileSize() const { return mappedSize_; }
+
+    // Índice de la columna con ese nombre; lanza si no existe
+    std::size_t columnIndex(const std::string& name) const;
+
+    std::size_t chunkRows(std::size_t chunk) const { return chunkRows_[chunk]; }
+
+    template<typename T>
+    const T* chunkColumn(std::size_t chunk, std::size_t column) const {
+        return reinterpret_cast<const T*>(columnData(chunk, column, sizeof(T)));
+    }
+
+    template<typename T>
+    std::vector<T> column(std::size_t index) const {
+        std::vector<T> values;
+        values.reserve(rows_);
+        for (std::size_t k = 0; k < chunks(); ++k) {
+            const T* data = chunkColumn<T>(k, index);
+            values.insert(values.end(), data, data + chunkRows(k));
+        }
+        return values;
+    }
+
+private:
+    const unsigned char* columnData(std::size_t chunk, std::size_t column, std::size_t width) const;
+
+    void* mapped_ = nullptr;
+    std::size_t mappedSize_ = 0;
+    std::size_t rows_ = 0;
+    std::vector<ColumnSpec> schema_;
+    std::vector<std::size_t> chunkRows_;
+    std::vector<std::uint64_t> columnOffsets_;   // [bloque][columna]
+};
+
+#endif // RESULT_EXPORT_HPP
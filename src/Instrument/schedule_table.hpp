@@ -0,0 +1,121 @@
+#ifndef SCHEDULE_TABLE_HPP
+#define SCHEDULE_TABLE_HPP
+
+#include <array>
+#include <utility>
+#include <boost/date_time/gregorian/gregorian.hpp>
+
+/*
+ * Calendarios estándar generados en compilación
+ * =============================================
+ * Para las frecuencias habituales (1, 2, 4 y 12 pagos al año) los desfases en
+ * meses de cada periodo se calculan en compilación. Para los plazos estándar
+ * además el número de periodos es constante, así que el bucle que ancla el
+ * patrón a la fecha de inicio queda desenrollado. El trabajo por operación es
+ * solo sumar cada desfase a la fecha de inicio.
+ *
+ * Las fechas se anclan siempre a la fecha de inicio (inicio + k * m meses), no
+ * al pago anterior, para que los fines de mes no vayan derivando.
+ */
+
+namespace schedule {
+
+constexpr int kMaxYears = 50;
+
+constexpr bool isStandardFrequency(int frequency) {
+    return frequency == 1 || frequency == 2 || frequency == 4 || frequency == 12;
+}
+
+// Desfases en meses de cada fecha del calendario: monthOffsets[k] = k * 12 / Frequency
+template<int Frequency>
+struct PeriodPattern {
+    static_assert(isStandardFrequency(Frequency), "Frecuencia no estándar");
+
+    static constexpr int monthsPerPeriod = 12 / Frequency;
+    static constexpr int maxPeriods = kMaxYears * Frequency;
+
+    static constexpr std::array<int, maxPeriods + 1> makeOffsets() {
+        std::array<int, maxPeriods + 1> offsets{};
+        for (int k = 0; k <= maxPeriods; ++k) offsets[k] = k * monthsPerPeriod;
+        return offsets;
+    }
+
+    static constexpr std::array<int, maxPeriods + 1> monthOffsets = makeOffsets();
+};
+
+// Calendario de un plazo estándar: número de periodos conocido en compilación
+template<int Frequency, int TenorMonths>
+struct StandardSchedule {
+    using Pattern = PeriodPattern<Frequency>;
+    static constexpr int periods = (TenorMonths + Pattern::monthsPerPeriod - 1) / Pattern::monthsPerPeriod;
+    static_assert(periods <= Pattern::maxPeriods, "Plazo fuera de la tabla");
+
+    // Llama a visit(k, fecha) para cada pago k = 0 .. periods-1, sin bucle
+    template<typename Visitor>
+    static void anchor(const boost::gregorian::date& start, Visitor& visit) {
+        anchorPeriods(start, visit, std::make_integer_sequence<int, periods>{});
+    }
+
+private:
+    template<typename Visitor, int... K>
+    static void anchorPeriods(const boost::gregorian::date& start, Visitor& visit,
+                              std::integer_sequence<int, K...>) {
+        (visit(K, start + boost::gregorian::months(Pattern::monthOffsets[K + 1])), ...);
+    }
+};
+
+// Despacha los plazos estándar (en meses) a su calendario desenrollado
+template<int Frequency, typename Visitor>
+bool anchorStandardTenor(const boost::gregorian::date& start, int tenorMonths, Visitor& visit) {
+    switch (tenorMonths) {
+        case 6:   StandardSchedule<Frequency, 6>::anchor(start, visit);   return true;
+        case 12:  StandardSchedule<Frequency, 12>::anchor(start, visit);  return true;
+        case 18:  StandardSchedule<Frequency, 18>::anchor(start, visit);  return true;
+        case 24:  StandardSchedule<Frequency, 24>::anchor(start, visit);  return true;
+        case 36:  StandardSchedule<Frequency, 36>::anchor(start, visit);  return true;
+        case 48:  StandardSchedule<Frequency, 48>::anchor(start, visit);  return true;
+        case 60:  StandardSchedule<Frequency, 60>::anchor(start, visit);  return true;
+        case 84:  StandardSchedule<Frequency, 84>::anchor(start, visit);  return true;
+        case 120: StandardSchedule<Frequency, 120>::anchor(start, visit); return true;
+        default:  return false;
+    }
+}
+
+// Plazo no estándar con frecuencia estándar: recorre la tabla precalculada
+template<int Frequency, typename Visitor>
+void anchorPattern(const boost::gregorian::date& start, int periods, Visitor& visit) {
+    using Pattern = PeriodPattern<Frequency>;
+    if (anchorStandardTenor<Frequency>(start, periods * Pattern::monthsPerPeriod, visit)) return;
+
+    for (int k = 0; k < periods; ++k) {
+        int offset = (k + 1 <= Pattern::maxPeriods) ? Pattern::monthOffsets[k + 1]
+                                                    : (k + 1) * Pattern::monthsPerPeriod;
+        visit(k, start + boost::gregorian::months(offset));
+    }
+}
+
+// Llama a visit(k, fecha) con las `periods` fechas de pago posteriores a start
+template<typename Visitor>
+void forEachPaymentDate(const boost::gregorian::date& start, int frequency, int periods, Visitor&& visit) {
+    switch (frequency) {
+        case 1:  anchorPattern<1>(start, periods, visit);  return;
+        case 2:  anchorPattern<2>(start, periods, visit);  return;
+        case 4:  anchorPattern<4>(start, periods, visit);  return;
+        case 12: anchorPattern<12>(start, periods, visit); return;
+        default: {
+            int monthsPerPeriod = 12 / frequency;
+            for (int k = 0; k < periods; ++k) {
+                visit(k, start + boost::gregorian::months((k + 1) * monthsPerPeriod));
+            }
+        }
+    }
+}
+
+// Número de periodos necesarios para cubrir tenorMonths con la frecuencia dada
+constexpr int periodsForTenor(int frequency, int tenorMonths) {
+    return (tenorMonths + 12 / frequency - 1) / (12 / frequency);
+}
+
+} // namespace schedule
+
+#endif // SCHEDULE_TABLE_HPP
@@ -2,6 +2,8 @@
 #include "actual_360.hpp"
 #include "thirty_360.hpp"
 #include "day_count_calculator.hpp"
+#include "schedule_table.hpp"
+#include "fast_math.hpp"
 #include <iostream>
 #include <iomanip>
 #include <cmath>
@@ -11,27 +13,88 @@ Swap::Swap(const InstrumentDescription& desc)
       fixedFrequency_(desc.fixedFrequency), floatingFrequency_(desc.floatingFrequency),
       initialFloatingRate_(desc.initialFixing), floatingIndex_(desc.floatingIndex),
       dayCountConvention_(desc.dayCountConvention), issueDate_(desc.issueDate),
-      maturity_(desc.maturity), zeroCouponCurve_(desc.zeroCouponCurve) {}
+      maturity_(desc.maturity), zeroCouponCurve_(desc.zeroCouponCurve),
+      curveHandle_(desc.curveHandle), curveRegistry_(desc.curveRegistry) {
+    if (curveRegistry_) {
+        // Los nombres se resuelven una sola vez; el pricing solo usa los ids
+        discountId_ = curveRegistry_->intern(desc.discountCurve);
+        forwardId_ = curveRegistry_->intern(desc.floatingIndex);
+    }
+    buildSchedule();
+}
 
-double Swap::price() const {
-    std::cout << "\n>>> Calculando flujos y precio del swap:\n";
-    std::cout << "Notional: " << notional_ << "\n"
-              << "Fixed Rate: " << fixedRate_ << "\n"
-              << "Maturity: " << maturity_ << " años\n"
-              << "Fixed Frequency: " << fixedFrequency_ << " pagos por año\n"
-              << "Floating Frequency: " << floatingFrequency_ << " pagos por año\n\n";
-
-    std::unique_ptr<DayCountCalculator> dayCountCalculator;
+void Swap::buildSchedule() {
+    Actual_360 actual360;
+    Thirty_360 thirty360;
+    const DayCountCalculator* dayCountCalculator = nullptr;
     if (dayCountConvention_ == "ACT/360") {
-        dayCountCalculator = std::make_unique<Actual_360>();
+        dayCountCalculator = &actual360;
     } else if (dayCountConvention_ == "30/360") {
-        dayCountCalculator = std::make_unique<Thirty_360>();
+        dayCountCalculator = &thirty360;
     } else {
         throw std::invalid_argument("Convención de días no soportada.");
     }
 
-    boost::gregorian::date paymentDate = issueDate_;
+    // Mismas fechas que price(): patrón estándar anclado a la fecha de emisión
+    int periods = static_cast<int>(maturity_ * fixedFrequency_);
+    fixedTimes_.resize(periods);
+    fixedAccruals_.resize(periods);
+
     boost::gregorian::date previousPaymentDate = issueDate_;
+    schedule::forEachPaymentDate(issueDate_, static_cast<int>(fixedFrequency_), periods,
+        [&](int i, const boost::gregorian::date& paymentDate) {
+            fixedTimes_[i] = static_cast<double>(dayCountCalculator->compute_daycount(issueDate_, paymentDate)) / 360.0;
+            fixedAccruals_[i] = static_cast<double>(dayCountCalculator->compute_daycount(previousPaymentDate, paymentDate)) / 360.0;
+            previousPaymentDate = paymentDate;
+        });
+
+    // Primer periodo flotante: se paga con el fixing inicial
+    double floatingFrequency = floatingFrequency_ > 0 ? floatingFrequency_ : fixedFrequency_;
+    boost::gregorian::date firstFloatingDate =
+        issueDate_ + boost::gregorian::months(static_cast<int>(12 / floatingFrequency));
+    firstFloatingAccrual_ = static_cast<double>(dayCountCalculator->compute_daycount(issueDate_, firstFloatingDate)) / 360.0;
+    firstFloatingTime_ = firstFloatingAccrual_;
+    lastFloatingTime_ = fixedTimes_.empty() ? 0.0 : fixedTimes_.back();
+}
+
+void Swap::cashflows(const ZeroCouponCurve& forwardCurve, CashflowBuffer& buffer) const {
+    projectCashflows(forwardCurve, buffer);
+}
+
+double Swap::price() const {
+    if (curveRegistry_) {
+        CurveHandle::ReadGuard discount(curveRegistry_->handle(discountId_));
+        CurveHandle::ReadGuard forward(curveRegistry_->handle(forwardId_));
+        return price(discount.curve(), forward.curve());
+    }
+    if (curveHandle_) {
+        // Toda la valoración usa la misma curva aunque se publique otra en paralelo
+        CurveHandle::ReadGuard guard(*curveHandle_);
+        return price(guard.curve());
+    }
+    return price(*zeroCouponCurve_);
+}
+
+double Swap::price(const ZeroCouponCurve& curve) const {
+    return price(curve, curve);
+}
+
+// Proyecta los forwards con forwardCurve y descuenta los flujos con discountCurve.
+// Usa el calendario precalculado: sin trazas no se reserva memoria.
+double Swap::price(const ZeroCouponCurve& discountCurve, const ZeroCouponCurve& forwardCurve) const {
+    if (verbose_) {
+        std::cout << "\n>>> Calculando flujos y precio del swap:\n";
+        std::cout << "Notional: " << notional_ << "\n"
+                  << "Fixed Rate: " << fixedRate_ << "\n"
+                  << "Maturity: " << maturity_ << " años\n"
+                  << "Fixed Frequency: " << fixedFrequency_ << " pagos por año\n"
+                  << "Floating Frequency: " << floatingFrequency_ << " pagos por año\n\n";
+
+        std::cout << "Periodo | Fecha Pago | dcf Flotante | dcf FIjo | DF | Forward Rate | Float Rate | Fixed CF | Float CF | PV Fixed | PV Float\n";
+        std::cout << "----------------------------------------------------------------------------------------------------------------------------------------\n";
+    }
+
+    boost::gregorian::date paymentDate = issueDate_;
 
     double previousTime = 0.0;
     double currentFloatingRate = initialFloatingRate_;
@@ -39,21 +102,17 @@ double Swap::price() const {
     double pvFixed = 0.0;
     double pvFloating = 0.0;
 
-    std::cout << "Periodo | Fecha Pago | dcf Flotante | dcf FIjo | DF | Forward Rate | Float Rate | Fixed CF | Float CF | PV Fixed | PV Float\n";
-    std::cout << "----------------------------------------------------------------------------------------------------------------------------------------\n";
+    for (size_t i = 0; i < fixedTimes_.size(); ++i) {
+        int period = static_cast<int>(i) + 1;
+        double timeToPayment = fixedTimes_[i];
+        double accrual = fixedAccruals_[i];
 
-    for (int period = 1; period <= static_cast<int>(maturity_ * fixedFrequency_); ++period) {
-        paymentDate += boost::gregorian::months(static_cast<int>(12 / fixedFrequency_));
-
-        double timeToPayment = static_cast<double>(dayCountCalculator->compute_daycount(issueDate_, paymentDate)) / 360.0;
-        double accrual = static_cast<double>(dayCountCalculator->compute_daycount(previousPaymentDate, paymentDate)) / 360.0;
-
-        double DF = zeroCouponCurve_->getDiscountFactor(timeToPayment);
+        double DF = discountCurve.getDiscountFactor(timeToPayment);
 
         double forwardContinuous = 0.0;
         if (period > 1) {
-            forwardContinuous = zeroCouponCurve_->forwardRate(previousTime, timeToPayment);
-            currentFloatingRate = fixedFrequency_ * (std::exp(forwardContinuous / fixedFrequency_) - 1);
+            forwardContinuous = forwardCurve.forwardRate(previousTime, timeToPayment);
+            currentFloatingRate = fixedFrequency_ * (fastmath::exp(forwardContinuous / fixedFrequency_) - 1);
         }
 
         double fixedCashFlow = notional_ * fixedRate_ * accrual;
@@ -62,36 +121,53 @@ double Swap::price() const {
         pvFixed += fixedCashFlow * DF;
         pvFloating += floatingCashFlow * DF;
 
-        std::cout << std::setw(7) << period << " | "
-                << paymentDate << " | "
-                << std::fixed << std::setprecision(6) << timeToPayment << " | "
-                << std::fixed << std::setprecision(6) << accrual << " | "
-                << std::fixed << std::setprecision(5) << DF << " | "
-                << std::fixed << std::setprecision(6) << forwardContinuous << " | "
-                << std::fixed << std::setprecision(3) << (currentFloatingRate * 100) << "% | "
-                << std::setw(8) << std::setprecision(3) << fixedCashFlow << "M | "
-                << std::setw(8) << std::setprecision(3) << floatingCashFlow << "M | "
-                << std::setw(8) << std::setprecision(3) << pvFixed << "M | "
-                << std::setw(8) << std::setprecision(3) << pvFloating << "M\n";
-
-        previousPaymentDate = paymentDate;
+        if (verbose_) {
+            paymentDate = issueDate_ + boost::gregorian::months(period * static_cast<int>(12 / fixedFrequency_));
+            std::cout << std::setw(7) << period << " | "
+                    << paymentDate << " | "
+                    << std::fixed << std::setprecision(6) << timeToPayment << " | "
+                    << std::fixed << std::setprecision(6) << accrual << " | "
+                    << std::fixed << std::setprecision(5) << DF << " | "
+                    << std::fixed << std::setprecision(6) << forwardContinuous << " | "
+                    << std::fixed << std::setprecision(3) << (currentFloatingRate * 100) << "% | "
+                    << std::setw(8) << std::setprecision(3) << fixedCashFlow << "M | "
+                    << std::setw(8) << std::setprecision(3) << floatingCashFlow << "M | "
+                    << std::setw(8) << std::setprecision(3) << pvFixed << "M | "
+                    << std::setw(8) << std::setprecision(3) << pvFloating << "M\n";
+        }
+
         previousTime = timeToPayment;
     }
-    double finalDF = zeroCouponCurve_->getDiscountFactor(maturity_);
+    double finalDF = discountCurve.getDiscountFactor(maturity_);
     pvFixed += notional_ * finalDF;
     pvFloating += notional_ * finalDF;
 
-    std::cout << "---------------------------------------------------------------------------------------------------\n";
-    std::cout << "Valor Presente al | " << paymentDate << " Con un Factor de descuento de: " 
-              << std::fixed << std::setprecision(5) << finalDF << " "
-              << " y un valor presente fijo de: " 
-              << pvFixed << "M | "
-              << " y un valor presente flotante de: " 
-              << pvFloating << "M\n";
-
     double npv = pvFixed - pvFloating;
 
-    std::cout << "\n>>> Precio calculado del Swap (NPV): " << npv << "\n";
+    if (verbose_) {
+        std::cout << "---------------------------------------------------------------------------------------------------\n";
+        std::cout << "Valor Presente al | " << paymentDate << " Con un Factor de descuento de: " 
+                  << std::fixed << std::setprecision(5) << finalDF << " "
+                  << " y un valor presente fijo de: " 
+                  << pvFixed << "M | "
+                  << " y un valor presente flotante de: " 
+                  << pvFloating << "M\n";
+
+        std::cout << "\n>>> Precio calculado del Swap (NPV): " << npv << "\n";
+    }
 
     return npv;
-}
\ No newline at end of file
+}
+
+CurveStamp Swap::curveStamp() const {
+    if (curveRegistry_) {
+        CurveHandle::ReadGuard discount(curveRegistry_->handle(discountId_));
+        CurveHandle::ReadGuard forward(curveRegistry_->handle(forwardId_));
+        return {discount.curve().version(), forward.curve().version()};
+    }
+    if (curveHandle_) {
+        CurveHandle::ReadGuard guard(*curveHandle_);
+        return {guard.curve().version(), 0};
+    }
+    return {zeroCouponCurve_->version(), 0};
+}
@@ -4,15 +4,76 @@
 #include "instrument.hpp"
 #include "instrument_description.hpp"
 #include "zero_coupon_curve.hpp"
+#include "pricing_kernels.hpp"
+#include "cashflow.hpp"
 #include <boost/date_time/gregorian/gregorian.hpp>
+#include <vector>
 
-class Swap : public Instrument {
+// Resultado de la valoración rápida de un swap (por unidad de notional en la anualidad)
+struct SwapValuation {
+    double annuity;   // Σ accrual_i * DF(t_i) de la pata fija
+    double parRate;   // Tasa fija que hace NPV = 0
+    double npv;       // PV fijo - PV flotante, mismo signo que price()
+};
+
+// Valoración y riesgo del swap frente a un spread continuo s aplicado en el
+// tiempo de cada flujo (DF(t) -> DF(t) * exp(-s t), ver SpreadCurve), también
+// en la proyección del flotante. No equivale a desplazar las tasas de los
+// pilares cuando hay flujos entre pilares o tras el último.
+struct SwapRisk {
+    double npv;
+    double annuity;
+    double parRate;
+    double pv01;   // Valor de 1pb en la tasa fija: notional * anualidad * 1e-4
+    double dv01;   // Cambio de NPV por -1pb de la curva
+};
+
+class Swap final : public Instrument {
 public:
     Swap(const InstrumentDescription& description);
 
     double price() const;
+    double price(const ZeroCouponCurve& curve) const;
+    double price(const ZeroCouponCurve& discountCurve, const ZeroCouponCurve& forwardCurve) const;
+    CurveStamp curveStamp() const override;
     double getFixedFrequency() const { return fixedFrequency_; };
 
+    // Valoración rápida monocurva: la pata flotante se telescopa a
+    // DF(inicio) - DF(fin), así solo se recorre la pata fija una vez.
+    // Usa forwards simples, no la capitalización efectiva de price().
+    // Acepta cualquier curva de descuento (ver discount_curve.hpp).
+    template<typename Curve>
+    SwapValuation valuation(const Curve& curve) const;
+    template<typename Curve>
+    double annuity(const Curve& curve) const { return valuation(curve).annuity; }
+    template<typename Curve>
+    double parRate(const Curve& curve) const { return valuation(curve).parRate; }
+    template<typename Curve>
+    double npv(const Curve& curve) const { return valuation(curve).npv; }
+
+    // Valoración a un horizonte (en años) sin reconstruir el swap: los tiempos
+    // se desplazan, los flujos ya pagados se descartan (su importe va en paid) y
+    // rolled es la curva vista desde el horizonte. Los fixings de periodos ya
+    // iniciados se toman de la curva de hoy (base).
+    template<typename Curve, typename BaseCurve>
+    HorizonValue valueAt(const Curve& rolled, const BaseCurve& base, double horizon) const;
+
+    // Flujos del swap, con el mismo signo que npv(): fijo a cobrar, flotante a pagar.
+    // Los flotantes se proyectan con forwards simples de forwardCurve, así que
+    // descontarlos con la misma curva reproduce valuation().
+    void cashflows(const ZeroCouponCurve& forwardCurve, CashflowBuffer& buffer) const override;
+    template<typename Curve>
+    void projectCashflows(const Curve& forwardCurve, CashflowBuffer& buffer) const;
+
+    // Valoración y riesgo en la misma pasada que valuation()
+    template<typename Curve>
+    SwapRisk risk(const Curve& curve) const;
+
+    // Valoración en lote de muchos swaps contra la misma curva
+    template<typename Curve>
+    static void valuations(const std::vector<const Swap*>& swaps, const Curve& curve,
+                           std::vector<SwapValuation>& results);
+
 private:
     double notional_;
     double fixedRate_;
@@ -25,8 +86,137 @@ private:
     double maturity_;
 
     std::shared_ptr<ZeroCouponCurve> zeroCouponCurve_;
+    std::shared_ptr<CurveHandle> curveHandle_;
+    std::shared_ptr<CurveRegistry> curveRegistry_;
+    CurveRegistry::CurveId discountId_ = 0;
+    CurveRegistry::CurveId forwardId_ = 0;
+
+    // Calendario precalculado (no depende de la curva)
+    std::vector<double> fixedTimes_;      // Tiempo hasta cada pago fijo
+    std::vector<double> fixedAccruals_;   // Fracción de devengo de cada periodo fijo
+    double firstFloatingTime_ = 0.0;      // Fin del primer periodo flotante (fixing conocido)
+    double firstFloatingAccrual_ = 0.0;
+    double lastFloatingTime_ = 0.0;
 
+    void buildSchedule();
     double accrualFraction(const boost::gregorian::date& start, const boost::gregorian::date& end) const;
 };
 
+template<typename Curve>
+SwapValuation Swap::valuation(const Curve& curve) const {
+    SwapValuation result{0.0, 0.0, 0.0};
+    if (fixedTimes_.empty()) return result;
+
+    result.annuity = discountedSum(curve, fixedTimes_, fixedAccruals_);
+
+    /* Pata flotante telescopada:
+     * Σ L_i * τ_i * DF(t_i) = Σ (DF(t_{i-1}) - DF(t_i)) = DF(t_1) - DF(t_n)
+     * más el primer periodo, que se paga con el fixing conocido.
+     */
+    double dfFirst = curve.getDiscountFactor(firstFloatingTime_);
+    double floatingLeg = initialFloatingRate_ * firstFloatingAccrual_ * dfFirst
+                       + dfFirst - curve.getDiscountFactor(lastFloatingTime_);
+
+    result.parRate = floatingLeg / result.annuity;
+    result.npv = notional_ * (fixedRate_ * result.annuity - floatingLeg);
+    return result;
+}
+
+template<typename Curve>
+void Swap::projectCashflows(const Curve& forwardCurve, CashflowBuffer& buffer) const {
+    double previousTime = 0.0;
+    for (size_t i = 0; i < fixedTimes_.size(); ++i) {
+        double t = fixedTimes_[i];
+        buffer.add(t, notional_ * fixedRate_ * fixedAccruals_[i],
+                   {CashflowLeg::Fixed, notional_, fixedAccruals_[i], fixedRate_, previousTime, t, false});
+        previousTime = t;
+    }
+    if (fixedTimes_.empty()) return;
+
+    // Primer periodo con el fixing conocido; los siguientes terminan en las fechas fijas
+    double periodStart = 0.0;
+    double periodEnd = firstFloatingTime_;
+    buffer.add(periodEnd, -notional_ * initialFloatingRate_ * firstFloatingAccrual_,
+               {CashflowLeg::Floating, -notional_, firstFloatingAccrual_, initialFloatingRate_,
+                periodStart, periodEnd, false});
+    for (double t : fixedTimes_) {
+        if (t <= periodEnd) continue;
+        periodStart = periodEnd;
+        periodEnd = t;
+        double accrual = periodEnd - periodStart;
+        double forward = (forwardCurve.getDiscountFactor(periodStart)
+                          / forwardCurve.getDiscountFactor(periodEnd) - 1.0) / accrual;
+        buffer.add(periodEnd, -notional_ * forward * accrual,
+                   {CashflowLeg::Floating, -notional_, accrual, forward, periodStart, periodEnd, true});
+    }
+}
+
+template<typename Curve, typename BaseCurve>
+HorizonValue Swap::valueAt(const Curve& rolled, const BaseCurve& base, double horizon) const {
+    HorizonValue result;
+    if (fixedTimes_.empty()) return result;
+
+    // Pata fija: anualidad desde el horizonte y cupones ya cobrados
+    HorizonValue fixedLeg = discountedSumAt(rolled, fixedTimes_, fixedAccruals_, horizon);
+
+    /* Pata flotante: el periodo en curso [a, b] ya tiene fixing, el resto telescopa.
+     * PV = F * DF'(b - h) - DF'(t_n - h), con F = 1 + L * τ del periodo en curso
+     * (L = fixing inicial en el primero, forward de hoy DF(a)/DF(b) - 1 en los demás).
+     */
+    double floatingPaid = 0.0;
+    double floatingLeg = 0.0;
+    double periodEnd = firstFloatingTime_;
+    double periodFactor = 1.0 + initialFloatingRate_ * firstFloatingAccrual_;
+    size_t next = 0;
+    while (periodEnd <= horizon && periodEnd < lastFloatingTime_) {
+        floatingPaid += periodFactor - 1.0;
+        while (next < fixedTimes_.size() && fixedTimes_[next] <= periodEnd) ++next;
+        double periodStart = periodEnd;
+        periodEnd = fixedTimes_[next];
+        periodFactor = base.getDiscountFactor(periodStart) / base.getDiscountFactor(periodEnd);
+    }
+    if (periodEnd <= horizon) {
+        floatingPaid += periodFactor - 1.0;
+    } else {
+        floatingLeg = periodFactor * rolled.getDiscountFactor(periodEnd - horizon)
+                    - rolled.getDiscountFactor(lastFloatingTime_ - horizon);
+    }
+
+    result.pv = notional_ * (fixedRate_ * fixedLeg.pv - floatingLeg);
+    result.paid = notional_ * (fixedRate_ * fixedLeg.paid - floatingPaid);
+    return result;
+}
+
+template<typename Curve>
+SwapRisk Swap::risk(const Curve& curve) const {
+    SwapRisk result{0.0, 0.0, 0.0, 0.0, 0.0};
+    if (fixedTimes_.empty()) return result;
+
+    // Anualidad y su derivada respecto al desplazamiento: d(DF)/ds = -t * DF
+    DiscountedMoments fixedLeg = discountedMoments(curve, fixedTimes_, fixedAccruals_);
+    result.annuity = fixedLeg.pv;
+    double annuitySlope = -fixedLeg.first;
+
+    double dfFirst = curve.getDiscountFactor(firstFloatingTime_);
+    double dfLast = curve.getDiscountFactor(lastFloatingTime_);
+    double firstFactor = 1.0 + initialFloatingRate_ * firstFloatingAccrual_;
+    double floatingLeg = firstFactor * dfFirst - dfLast;
+    double floatingSlope = -firstFactor * firstFloatingTime_ * dfFirst + lastFloatingTime_ * dfLast;
+
+    result.parRate = floatingLeg / result.annuity;
+    result.npv = notional_ * (fixedRate_ * result.annuity - floatingLeg);
+    result.pv01 = notional_ * result.annuity * 1e-4;
+    result.dv01 = -notional_ * (fixedRate_ * annuitySlope - floatingSlope) * 1e-4;
+    return result;
+}
+
+template<typename Curve>
+void Swap::valuations(const std::vector<const Swap*>& swaps, const Curve& curve,
+                      std::vector<SwapValuation>& results) {
+    results.resize(swaps.size());
+    for (size_t i = 0; i < swaps.size(); ++i) {
+        results[i] = swaps[i]->valuation(curve);
+    }
+}
+
 #endif // SWAP_HPP
\ No newline at end of file
@@ -5,6 +5,11 @@ std::unique_ptr<Instrument> SwapBuilder::build(const InstrumentDescription& desc
     return std::make_unique<Swap>(description);  // Aquí se pasa el descriptor completo
 }
 
+Swap SwapBuilder::buildValue(const InstrumentDescription& description) {
+    description.validate();
+    return Swap(description);
+}
+
 InstrumentDescription::Type SwapBuilder::getId() {
     return InstrumentDescription::swap;
-}
\ No newline at end of file
+}
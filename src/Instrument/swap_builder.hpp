@@ -6,7 +6,10 @@
 
 class SwapBuilder {
 public:
+    using Product = Swap;  // Tipo concreto que construye (ver instrument_variant.hpp)
+
     static std::unique_ptr<Instrument> build(const InstrumentDescription& description);
+    static Swap buildValue(const InstrumentDescription& description);
     static InstrumentDescription::Type getId();
 };
 
@@ -0,0 +1,209 @@
+#define BOOST_TEST_MODULE AllocationFreeTest
+#include <boost/test/unit_test.hpp>
+#include "../bond.hpp"
+#include "../swap.hpp"
+#include "../curve_handle.hpp"
+#include "../curve_registry.hpp"
+#include "../curve_history_store.hpp"
+#include "../discount_curve_calibration.hpp"
+#include "../instrument_description.hpp"
+#include "../zero_coupon_curve.hpp"
+#include "../factory_registrator.hpp"
+#include "../bond_builder.hpp"
+#include "../swap_builder.hpp"
+#include "test_fixtures.hpp"
+#include <cstdlib>
+#include <cmath>
+#include <cstdio>
+#include <new>
+
+static FactoryRegistrator<BondBuilder> bondRegistrator;
+static FactoryRegistrator<SwapBuilder> swapRegistrator;
+
+/* Sustituimos el operator new global del ejecutable (también lo usa la
+ * librería Instrument) para contar las reservas de memoria del hilo actual
+ * mientras se ejecuta el código medido. Las reservas de Boost.Test quedan
+ * fuera porque solo se cuenta dentro de countAllocations().
+ */
+namespace {
+thread_local bool counting = false;
+thread_local std::size_t allocations = 0;
+
+void* allocate(std::size_t size) {
+    if (counting) ++allocations;
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+template<typename F>
+std::size_t countAllocations(F&& f) {
+    allocations = 0;
+    counting = true;
+    f();
+    counting = false;
+    return allocations;
+}
+} // namespace
+
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+static void addQuotes(CurveCalibrator& calibrator, double shift) {
+    calibrator.addDeposit(5.0 + shift, 6);
+    calibrator.addSwap(5.5 + shift, 12);
+    calibrator.addSwap(6.0 + shift, 18);
+    calibrator.addSwap(6.4 + shift, 24);
+    calibrator.addSwap(6.6 + shift, 36);
+}
+
+BOOST_AUTO_TEST_SUITE(AllocationFreeSuite)
+
+BOOST_AUTO_TEST_CASE(TestHarnessCountsAllocations) {
+    std::size_t count = countAllocations([] {
+        std::vector<double> v(16);
+        v.push_back(1.0);
+    });
+    BOOST_CHECK_EQUAL(count, 2u);
+}
+
+BOOST_AUTO_TEST_CASE(TestSilentPriceMatchesVerbose) {
+    InstrumentDescription bondDesc = bondDescription(0.06);
+    bondDesc.zeroCouponCurve = testCurve();
+    Bond bond(bondDesc);
+    InstrumentDescription swapDesc = swapDescription(0.05);
+    swapDesc.zeroCouponCurve = testCurve();
+    Swap swap(swapDesc);
+
+    BOOST_CHECK(bond.verbose());
+    double bondVerbose = bond.price();
+    double swapVerbose = swap.price();
+    bond.setVerbose(false);
+    swap.setVerbose(false);
+    BOOST_CHECK_EQUAL(bond.price(), bondVerbose);
+    BOOST_CHECK_EQUAL(swap.price(), swapVerbose);
+}
+
+BOOST_AUTO_TEST_CASE(TestCurveLookupsDoNotAllocate) {
+    auto curve = testCurve();
+    auto handle = std::make_shared<CurveHandle>(testCurve());
+    CurveRegistry registry;
+    std::string name = "EUR-ESTR";
+    auto id = registry.publish(name, testCurve());
+    { CurveHandle::ReadGuard warmUp(*handle); }  // Primera lectura del hilo: toma su slot
+
+    double sink = 0.0;
+    std::size_t count = countAllocations([&] {
+        for (double t = 0.1; t < 3.0; t += 0.1) {
+            sink += curve->getDiscountFactor(t);
+            sink += curve->forwardRate(t, t + 0.5);
+            sink += curve->getSpotRate(t, 2);
+        }
+        CurveHandle::ReadGuard guard(*handle);
+        sink += guard.curve().getDiscountFactor(1.0);
+        CurveHandle::ReadGuard byId(registry.handle(registry.find(name)));
+        sink += byId.curve().getDiscountFactor(1.0);
+    });
+    BOOST_CHECK_EQUAL(count, 0u);
+    BOOST_CHECK_GT(sink, 0.0);
+    BOOST_CHECK_EQUAL(registry.find(name), id);
+}
+
+BOOST_AUTO_TEST_CASE(TestPriceDoesNotAllocate) {
+    auto registry = std::make_shared<CurveRegistry>();
+    registry->publish("EUR-ESTR", testCurve());
+    registry->publish("Euribor6M", testCurve(0.1));
+    auto handle = std::make_shared<CurveHandle>(testCurve());
+    auto curve = testCurve();
+
+    InstrumentDescription bondDesc = bondDescription(0.06);
+    bondDesc.zeroCouponCurve = testCurve();
+    Bond bond(bondDesc);
+    bondDesc.zeroCouponCurve.reset();
+    bondDesc.curveHandle = handle;
+    Bond handleBond(bondDesc);
+
+    InstrumentDescription swapDesc = swapDescription(0.05);
+    swapDesc.zeroCouponCurve = testCurve();
+    Swap swap(swapDesc);
+    swapDesc.zeroCouponCurve.reset();
+    swapDesc.curveRegistry = registry;
+    swapDesc.discountCurve = "EUR-ESTR";
+    Swap registrySwap(swapDesc);
+
+    for (Instrument* instrument : {static_cast<Instrument*>(&bond), static_cast<Instrument*>(&handleBond),
+                                   static_cast<Instrument*>(&swap), static_cast<Instrument*>(&registrySwap)}) {
+        instrument->setVerbose(false);
+        instrument->price();  // Calentamiento: slot de lector del hilo
+    }
+
+    double sink = 0.0;
+    std::size_t count = countAllocations([&] {
+        for (int i = 0; i < 100; ++i) {
+            sink += bond.price() + handleBond.price();
+            sink += swap.price() + registrySwap.price();
+            sink += bond.presentValue(*curve) + swap.npv(*curve);
+        }
+    });
+    BOOST_CHECK_EQUAL(count, 0u);
+    BOOST_CHECK(std::isfinite(sink));
+}
+
+BOOST_AUTO_TEST_CASE(TestHistoryLookupDoesNotAllocate) {
+    const std::string path = "test_allocation_history.zchs";
+    auto curve = testCurve();
+    CurveHistoryStore::write(path, {{kBaseDate, "EUR", curve}, {kBaseDate + boost::gregorian::days(1), "EUR", testCurve(0.1)}});
+
+    {
+        CurveHistoryStore store(path);
+        double sink = 0.0;
+        std::size_t count = countAllocations([&] {
+            for (double t = 0.1; t < 3.0; t += 0.1) sink += store.discountFactor(kBaseDate, t);
+        });
+        BOOST_CHECK_EQUAL(count, 0u);
+        BOOST_CHECK_EQUAL(store.discountFactor(kBaseDate, 0.75), curve->getDiscountFactor(0.75));
+        BOOST_CHECK(std::isfinite(sink));
+    }
+    std::remove(path.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(TestRecalibrationDoesNotAllocate) {
+    boost::gregorian::date baseDate(2016, 4, 1);
+    CurveCalibrator calibrator(baseDate);
+    calibrator.setVerbose(false);
+    addQuotes(calibrator, 0.0);
+    auto curve = calibrator.calibrate();
+
+    std::vector<double> shifted = {5.1, 5.6, 6.1, 6.5, 6.7};
+    std::uint64_t version = curve->version();
+    std::size_t count = countAllocations([&] {
+        for (int i = 0; i < 10; ++i) calibrator.recalibrate(shifted, *curve);
+    });
+    BOOST_CHECK_EQUAL(count, 0u);
+    BOOST_CHECK_NE(curve->version(), version);
+
+    // Mismo resultado que una calibración desde cero con las nuevas cotizaciones
+    CurveCalibrator fresh(baseDate);
+    fresh.setVerbose(false);
+    addQuotes(fresh, 0.1);
+    std::shared_ptr<ZeroCouponCurve> expected;
+    // La librería también pasa por el contador: calibrate() sí reserva
+    BOOST_CHECK_GT(countAllocations([&] { expected = fresh.calibrate(); }), 0u);
+    BOOST_REQUIRE_EQUAL(curve->getZeroRates().size(), expected->getZeroRates().size());
+    for (size_t i = 0; i < expected->getZeroRates().size(); ++i) {
+        BOOST_CHECK_CLOSE(curve->getZeroRates()[i], expected->getZeroRates()[i], 1e-10);
+        for (size_t j = 0; j <= i; ++j) {
+            BOOST_CHECK_CLOSE(calibrator.zeroRateJacobian()[i][j], fresh.zeroRateJacobian()[i][j], 1e-8);
+        }
+    }
+
+    BOOST_CHECK_THROW(calibrator.recalibrate({5.0}, *curve), std::invalid_argument);
+    CurveCalibrator empty(baseDate);
+    BOOST_CHECK_THROW(empty.recalibrate(shifted, *curve), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,146 @@
+#define BOOST_TEST_MODULE CashflowLadderTest
+#include <boost/test/unit_test.hpp>
+#include "../cashflow_ladder.hpp"
+#include "../bond.hpp"
+#include "../swap.hpp"
+#include "../instrument_description.hpp"
+#include "../zero_coupon_curve.hpp"
+#include "../discount_curve.hpp"
+#include "test_fixtures.hpp"
+#include <memory>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(CashflowLadderSuite)
+
+struct Book {
+    std::vector<std::unique_ptr<Swap>> swaps;
+    std::vector<std::unique_ptr<Bond>> bonds;
+
+    template<typename Curve>
+    double value(const Curve& curve) const {
+        double sum = 0.0;
+        for (const auto& swap : swaps) sum += swap->npv(curve);
+        for (const auto& bond : bonds) sum += bond->presentValue(curve);
+        return sum;
+    }
+};
+
+static Book makeBook(int size, std::shared_ptr<ZeroCouponCurve> curve) {
+    Book book;
+    for (int i = 0; i < size; ++i) {
+        InstrumentDescription desc(InstrumentDescription::swap);
+        desc.notional = 1e6 * (1 + i % 5);
+        desc.fixedRate = 0.04 + 0.0001 * (i % 40);
+        desc.fixedFrequency = i % 3 == 0 ? 4.0 : 2.0;
+        desc.floatingFrequency = desc.fixedFrequency;
+        desc.initialFixing = 0.048;
+        desc.floatingIndex = "Euribor6M";
+        desc.dayCountConvention = "ACT/360";
+        desc.issueDate = boost::gregorian::date(2016, 4, 1);
+        desc.maturity = 1.0 + (i % 3) * 0.5;
+        desc.zeroCouponCurve = curve;
+        book.swaps.push_back(std::make_unique<Swap>(desc));
+    }
+    for (int i = 0; i < size / 10; ++i) {
+        InstrumentDescription desc(InstrumentDescription::bond);
+        desc.maturity = 2.0;
+        desc.couponRate = 0.03 + 0.001 * i;
+        desc.frequency = 2.0;
+        desc.notional = 100;
+        desc.issueDate = boost::gregorian::date(2016, 4, 1);
+        desc.couponDates = {0.5, 1.0, 1.5, 2.0};
+        desc.zeroCouponCurve = curve;
+        book.bonds.push_back(std::make_unique<Bond>(desc));
+    }
+    return book;
+}
+
+BOOST_AUTO_TEST_CASE(TestLadderMatchesTradeByTrade) {
+    auto curve = testCurve();
+    Book book = makeBook(1000, curve);
+
+    CashflowLadder ladder;
+    for (const auto& swap : book.swaps) ladder.add(*swap, *curve);
+    for (const auto& bond : book.bonds) ladder.add(*bond, *curve);
+
+    // Miles de flujos, pocas fechas de pago distintas
+    BOOST_CHECK_GT(ladder.cashflows(), 5000u);
+    BOOST_CHECK_LT(ladder.dates(), 20u);
+
+    BOOST_CHECK_CLOSE(ladder.value(*curve).total(), book.value(*curve), 1e-9);
+
+    // Revaloración con otras curvas sin volver a tocar los trades
+    for (double shift : {-1.0, 0.25, 2.0}) {
+        auto scenario = testCurve(shift);
+        BOOST_CHECK_CLOSE(ladder.value(*scenario).total(), book.value(*scenario), 1e-9);
+    }
+    FlatCurve flat(0.03);
+    BOOST_CHECK_CLOSE(ladder.value(flat).total(), book.value(flat), 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(TestRemoveRestoresLadder) {
+    auto curve = testCurve();
+    Book book = makeBook(20, curve);
+
+    CashflowLadder ladder;
+    for (const auto& swap : book.swaps) ladder.add(*swap, *curve);
+    std::size_t dates = ladder.dates();
+    double before = ladder.value(*curve).total();
+
+    // El principal del bono (t = 2.0) se suma al neto fijo de esa fecha
+    double netAtMaturity = ladder.fixedAmount(2.0);
+    ladder.add(*book.bonds[0], *curve);
+    BOOST_CHECK_CLOSE(ladder.fixedAmount(2.0), netAtMaturity + 100.0 * (1.0 + 0.03 / 2.0), 1e-10);
+    ladder.remove(*book.bonds[0], *curve);
+    BOOST_CHECK_EQUAL(ladder.dates(), dates);
+    BOOST_CHECK_CLOSE(ladder.value(*curve).total(), before, 1e-10);
+
+    for (const auto& swap : book.swaps) ladder.remove(*swap, *curve);
+    BOOST_CHECK_SMALL(ladder.value(*curve).total(), 1e-6);
+    BOOST_CHECK_EQUAL(ladder.cashflows(), 0u);
+    BOOST_CHECK_EQUAL(ladder.dates(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(TestRemoveAllDropsEveryDate) {
+    // Con cientos de nominales distintos el neto no vuelve a 0.0 exacto
+    auto curve = testCurve();
+    Book book = makeBook(200, curve);
+
+    CashflowLadder ladder;
+    for (const auto& swap : book.swaps) ladder.add(*swap, *curve);
+    BOOST_CHECK_GT(ladder.dates(), 0u);
+    for (const auto& swap : book.swaps) ladder.remove(*swap, *curve);
+    BOOST_CHECK_EQUAL(ladder.dates(), 0u);
+    BOOST_CHECK_EQUAL(ladder.cashflows(), 0u);
+    BOOST_CHECK_EQUAL(ladder.value(*curve).total(), 0.0);
+
+    // clear() deja la escalera vacía, incluido el contador de flujos
+    ladder.add(*book.bonds[0], *curve);
+    BOOST_CHECK_GT(ladder.cashflows(), 0u);
+    ladder.clear();
+    BOOST_CHECK_EQUAL(ladder.dates(), 0u);
+    BOOST_CHECK_EQUAL(ladder.cashflows(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(TestWeightedRemoveKeepsRemainingPosition) {
+    auto curve = testCurve();
+    Book book = makeBook(10, curve);
+    const Bond& bond = *book.bonds[0];
+
+    CashflowLadder single;
+    single.add(bond, *curve);
+
+    // Posición doble y retirada de una unidad: queda la mitad, con todas sus fechas
+    CashflowLadder ladder;
+    ladder.add(bond, *curve, 2.0);
+    ladder.remove(bond, *curve);
+    BOOST_CHECK_EQUAL(ladder.dates(), single.dates());
+    BOOST_CHECK_EQUAL(ladder.cashflows(), single.cashflows());
+    BOOST_CHECK_CLOSE(ladder.value(*curve).total(), bond.presentValue(*curve), 1e-10);
+
+    ladder.remove(bond, *curve);
+    BOOST_CHECK_EQUAL(ladder.dates(), 0u);
+    BOOST_CHECK_EQUAL(ladder.cashflows(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
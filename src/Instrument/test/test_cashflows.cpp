@@ -0,0 +1,117 @@
+#define BOOST_TEST_MODULE CashflowTest
+#include <boost/test/unit_test.hpp>
+#include "../cashflow.hpp"
+#include "../bond.hpp"
+#include "../swap.hpp"
+#include "../instrument_description.hpp"
+#include "../zero_coupon_curve.hpp"
+#include "../discount_curve.hpp"
+#include "test_fixtures.hpp"
+#include <memory>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(CashflowSuite)
+
+BOOST_AUTO_TEST_CASE(TestBondCashflowsMatchPresentValue) {
+    auto curve = testCurve();
+    Bond bond(bondDescription(0.06, curve));
+
+    CashflowBuffer buffer;
+    bond.cashflows(*curve, buffer);
+    BOOST_REQUIRE_EQUAL(buffer.size(), 5u);
+    BOOST_CHECK(buffer.info(0).leg == CashflowLeg::Fixed);
+    BOOST_CHECK(buffer.info(4).leg == CashflowLeg::Principal);
+    BOOST_CHECK_CLOSE(buffer.amount(0), 3.0, 1e-12);
+    BOOST_CHECK_CLOSE(buffer.amount(4), 100.0, 1e-12);
+
+    BOOST_CHECK_CLOSE(discountCashflows(*curve, buffer), bond.presentValue(*curve), 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(TestSwapCashflowsMatchValuation) {
+    auto curve = testCurve();
+    Swap swap(swapDescription(0.05, 2.0, curve));
+
+    CashflowBuffer buffer;
+    swap.cashflows(*curve, buffer);
+    BOOST_REQUIRE_EQUAL(buffer.size(), 8u);
+
+    std::size_t projected = 0;
+    for (std::size_t i = 0; i < buffer.size(); ++i) {
+        if (buffer.info(i).leg == CashflowLeg::Floating) {
+            BOOST_CHECK_LT(buffer.amount(i), 0.0);
+            if (buffer.info(i).projected) ++projected;
+        }
+    }
+    BOOST_CHECK_EQUAL(projected, 3u);
+    BOOST_CHECK_CLOSE(buffer.info(4).rate, 0.048, 1e-12);
+
+    BOOST_CHECK_CLOSE(discountCashflows(*curve, buffer), swap.npv(*curve), 1e-10);
+
+    // Proyección y descuento con curvas distintas
+    FlatCurve discount(0.04);
+    CashflowBuffer dual;
+    swap.projectCashflows(*curve, dual);
+    double expected = 0.0;
+    for (std::size_t i = 0; i < buffer.size(); ++i) {
+        expected += buffer.amount(i) * discount.getDiscountFactor(buffer.time(i));
+    }
+    BOOST_CHECK_CLOSE(discountCashflows(discount, dual), expected, 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(TestMixedBatchReusesBuffer) {
+    auto curve = testCurve();
+    std::vector<std::unique_ptr<Instrument>> book;
+    for (int i = 0; i < 20; ++i) {
+        if (i % 2 == 0) {
+            book.push_back(std::make_unique<Bond>(bondDescription(0.06, curve)));
+        } else {
+            book.push_back(std::make_unique<Swap>(swapDescription(0.04 + 0.001 * i, 2.0, curve)));
+        }
+    }
+
+    CashflowBuffer buffer;
+    std::vector<std::size_t> offsets;
+    auto emitAll = [&]() {
+        buffer.clear();
+        offsets.clear();
+        for (const auto& instrument : book) {
+            offsets.push_back(buffer.size());
+            instrument->cashflows(*curve, buffer);
+        }
+        offsets.push_back(buffer.size());
+    };
+
+    emitAll();
+    std::size_t capacity = buffer.capacity();
+    const double* data = buffer.times().data();
+    double total = discountCashflows(*curve, buffer);
+
+    // Segunda pasada: el buffer ya tiene capacidad y no se vuelve a reservar
+    emitAll();
+    BOOST_CHECK_EQUAL(buffer.capacity(), capacity);
+    BOOST_CHECK(buffer.times().data() == data);
+    BOOST_CHECK_CLOSE(discountCashflows(*curve, buffer), total, 1e-12);
+
+    double sum = 0.0;
+    for (std::size_t i = 0; i < book.size(); ++i) {
+        double pv = discountCashflows(*curve, buffer, offsets[i], offsets[i + 1]);
+        if (const Swap* swap = dynamic_cast<const Swap*>(book[i].get())) {
+            BOOST_CHECK_CLOSE(pv, swap->npv(*curve), 1e-10);
+        } else {
+            BOOST_CHECK_CLOSE(pv, static_cast<const Bond&>(*book[i]).presentValue(*curve), 1e-12);
+        }
+        sum += pv;
+    }
+    BOOST_CHECK_CLOSE(sum, total, 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE(TestDefaultBondHasNoCashflows) {
+    auto curve = testCurve();
+    Bond bond;
+    CashflowBuffer buffer;
+    bond.cashflows(*curve, buffer);
+    BOOST_CHECK_EQUAL(buffer.size(), 0u);
+    BOOST_CHECK_EQUAL(bond.price(*curve), 0.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
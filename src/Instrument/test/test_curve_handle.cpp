@@ -0,0 +1,145 @@
+#define BOOST_TEST_MODULE CurveHandleTest
+#include <boost/test/unit_test.hpp>
+#include "../curve_handle.hpp"
+#include "../swap.hpp"
+#include "../instrument_description.hpp"
+#include "../factory.hpp"
+#include "../swap_builder.hpp"
+#include "../factory_registrator.hpp"
+#include "../discount_curve_calibration.hpp"
+#include <thread>
+#include <atomic>
+#include <cmath>
+
+static FactoryRegistrator<SwapBuilder> swapRegistrator;
+
+// Curva plana al tipo indicado (en %), con pilares hasta 5 años
+static std::shared_ptr<ZeroCouponCurve> flatCurve(double rate) {
+    return std::make_shared<ZeroCouponCurve>(
+        std::vector<double>(5, rate), std::vector<double>{1.0, 2.0, 3.0, 4.0, 5.0});
+}
+
+BOOST_AUTO_TEST_SUITE(CurveHandleSuite)
+
+BOOST_AUTO_TEST_CASE(TestRetiredCurveReclaimedAfterReaderLeaves) {
+    auto first = flatCurve(3.0);
+    std::weak_ptr<ZeroCouponCurve> watcher = first;
+    CurveHandle handle(std::move(first));
+
+    {
+        CurveHandle::ReadGuard guard(handle);
+        handle.publish(flatCurve(4.0));
+
+        // El lector sigue viendo la curva con la que entró
+        BOOST_CHECK_CLOSE(guard.curve().getDiscountFactor(1.0), std::exp(-0.03), 1e-10);
+        BOOST_CHECK_EQUAL(handle.pendingReclamation(), 1u);
+        BOOST_CHECK(!watcher.expired());
+    }
+
+    handle.collect();
+    BOOST_CHECK_EQUAL(handle.pendingReclamation(), 0u);
+    BOOST_CHECK(watcher.expired());
+
+    CurveHandle::ReadGuard guard(handle);
+    BOOST_CHECK_CLOSE(guard.curve().getDiscountFactor(1.0), std::exp(-0.04), 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE(TestConcurrentReadersSeeConsistentCurve) {
+    CurveHandle handle(flatCurve(1.0));
+    std::atomic<bool> done{false};
+    std::atomic<int> inconsistent{0};
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&]() {
+            while (!done.load()) {
+                CurveHandle::ReadGuard guard(handle);
+                // En una curva plana DF(2) = DF(1)^2: solo se cumple si ambos vienen de la misma curva
+                double df1 = guard.curve().getDiscountFactor(1.0);
+                double df2 = guard.curve().getDiscountFactor(2.0);
+                if (std::fabs(df2 - df1 * df1) > 1e-12) ++inconsistent;
+            }
+        });
+    }
+
+    for (int i = 0; i < 2000; ++i) {
+        handle.publish(flatCurve(1.0 + (i % 50) * 0.1));
+    }
+    done = true;
+    for (auto& reader : readers) reader.join();
+
+    handle.collect();
+    BOOST_CHECK_EQUAL(inconsistent.load(), 0);
+    BOOST_CHECK_EQUAL(handle.pendingReclamation(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(TestSwapRepricesOnPublishWithoutRebuild) {
+    auto handle = std::make_shared<CurveHandle>(flatCurve(5.0));
+
+    InstrumentDescription desc(InstrumentDescription::swap);
+    desc.notional = 100;
+    desc.fixedRate = 0.05;
+    desc.fixedFrequency = 2.0;
+    desc.floatingFrequency = 2.0;
+    desc.initialFixing = 0.05;
+    desc.floatingIndex = "Euribor6M";
+    desc.dayCountConvention = "ACT/360";
+    desc.issueDate = boost::gregorian::date(2016, 4, 1);
+    desc.maturity = 2.0;
+    desc.curveHandle = handle;
+
+    auto swap = Factory::instance()(desc);
+    double before = swap->price();
+    CurveStamp stampBefore = swap->curveStamp();
+
+    handle->publish(flatCurve(6.0));
+    double after = swap->price();
+
+    BOOST_CHECK_NE(before, after);
+    BOOST_CHECK(swap->curveStamp() != stampBefore);
+}
+
+BOOST_AUTO_TEST_CASE(TestPublishedCurveIsReadOnly) {
+    auto curve = flatCurve(3.0);
+    BOOST_CHECK(!curve->published());
+    CurveHandle handle(curve);
+    BOOST_CHECK(curve->published());
+    BOOST_CHECK_THROW(curve->updateZeroRates(std::vector<double>(5, 4.0)), std::logic_error);
+
+    // Una copia es una curva nueva y se puede modificar
+    ZeroCouponCurve copy(*curve);
+    BOOST_CHECK(!copy.published());
+    copy.updateZeroRates(std::vector<double>(5, 4.0));
+    BOOST_CHECK_CLOSE(copy.getDiscountFactor(1.0), std::exp(-0.04), 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE(TestRecalibrateIntoHandle) {
+    CurveCalibrator calibrator(boost::gregorian::date(2016, 4, 1));
+    calibrator.setVerbose(false);
+    calibrator.addDeposit(5.0, 6);
+    calibrator.addSwap(5.5, 12);
+    calibrator.addSwap(6.0, 24);
+    auto initial = calibrator.calibrate();
+    CurveHandle handle(initial);
+    double before = initial->getDiscountFactor(1.5);
+
+    {
+        // El lector que ya estaba valorando sigue con la curva anterior
+        CurveHandle::ReadGuard guard(handle);
+        calibrator.recalibrate({5.2, 5.7, 6.2}, handle);
+        BOOST_CHECK_EQUAL(&guard.curve(), initial.get());
+        BOOST_CHECK_EQUAL(guard.curve().getDiscountFactor(1.5), before);
+    }
+
+    CurveHandle::ReadGuard guard(handle);
+    BOOST_CHECK(&guard.curve() != initial.get());
+    BOOST_CHECK_LT(guard.curve().getDiscountFactor(1.5), before);
+
+    // La curva publicada no se puede recalibrar en sitio, y el intento no
+    // cambia el estado del calibrador
+    std::vector<std::vector<double>> jacobian = calibrator.zeroRateJacobian();
+    BOOST_CHECK_THROW(calibrator.recalibrate({4.0, 4.5, 5.0}, *initial), std::logic_error);
+    BOOST_CHECK(calibrator.zeroRateJacobian() == jacobian);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,131 @@
+#define BOOST_TEST_MODULE CurveHistoryStoreTest
+#include <boost/test/unit_test.hpp>
+#include "../curve_history_store.hpp"
+#include "../historical_curve_builder.hpp"
+#include <sstream>
+#include <cstdio>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+// Histórico sintético de una divisa con cotizaciones que se mueven poco cada día
+static std::vector<HistoricalCurve> syntheticHistory(int days) {
+    std::ostringstream out;
+    boost::gregorian::date start(2016, 1, 1);
+    for (int d = 0; d < days; ++d) {
+        std::string date = boost::gregorian::to_iso_extended_string(start + boost::gregorian::days(d));
+        double shift = 0.25 * std::sin(d / 30.0);
+        out << date << ",EUR,DEPOSIT,6," << 1.0 + shift << '\n'
+            << date << ",EUR,SWAP,12," << 1.2 + shift << '\n'
+            << date << ",EUR,SWAP,24," << 1.5 + shift << '\n'
+            << date << ",EUR,SWAP,60," << 2.0 + shift << '\n'
+            << date << ",EUR,SWAP,120," << 2.6 + shift << '\n';
+    }
+    std::istringstream input(out.str());
+    return HistoricalCurveBuilder(2).build(HistoricalCurveBuilder::readQuotes(input));
+}
+
+BOOST_AUTO_TEST_SUITE(CurveHistoryStoreSuite)
+
+BOOST_AUTO_TEST_CASE(TestRoundTripAndPointQueries) {
+    std::vector<HistoricalCurve> history = syntheticHistory(300);
+    const std::string path = "test_curve_history_store.zchs";
+    CurveHistoryStore::write(path, history);
+
+    {
+        CurveHistoryStore store(path);
+        BOOST_REQUIRE_EQUAL(store.size(), history.size());
+        BOOST_CHECK_EQUAL(store.pillars(), 5u);
+        BOOST_CHECK_EQUAL(store.currency(), "EUR");
+        BOOST_CHECK_EQUAL(store.find(boost::gregorian::date(2015, 12, 31)), -1);
+        BOOST_CHECK_THROW(store.curveAt(boost::gregorian::date(2030, 1, 1)), std::invalid_argument);
+
+        for (size_t row : {0u, 63u, 64u, 150u, 299u}) {
+            const ZeroCouponCurve& original = *history[row].curve;
+            BOOST_CHECK_EQUAL(store.dateAt(row), history[row].date);
+            BOOST_CHECK_EQUAL(store.find(history[row].date), static_cast<long>(row));
+
+            // Reconstrucción exacta de la curva
+            auto restored = store.curveAt(history[row].date);
+            BOOST_CHECK(restored->getDiscountFactors() == original.getDiscountFactors());
+            BOOST_CHECK(restored->getDates() == original.getDates());
+
+            const std::vector<double>& pillars = original.getMaturities();
+            for (double t : {0.1, pillars[0], 0.75, pillars[2], 3.3, 9.0, pillars[4], 12.0}) {
+                BOOST_CHECK_EQUAL(store.discountFactor(history[row].date, t), original.getDiscountFactor(t));
+            }
+        }
+
+        // Recorrido secuencial de un pilar
+        size_t count = 0;
+        bool matches = true;
+        store.scanPillar(3, [&](const boost::gregorian::date& date, double maturity, double rate) {
+            matches = matches && date == history[count].date
+                      && maturity == history[count].curve->getMaturities()[3]
+                      && rate == history[count].curve->getZeroRates()[3];
+            ++count;
+        });
+        BOOST_CHECK_EQUAL(count, history.size());
+        BOOST_CHECK(matches);
+
+        // Más pequeño que guardar en crudo fechas, días y tasas de cada pilar
+        size_t raw = history.size() * (sizeof(std::int32_t) + store.pillars() * 2 * sizeof(double));
+        BOOST_TEST_MESSAGE("Tamaño comprimido: " << store.fileSize() << " bytes, en crudo: " << raw);
+        BOOST_CHECK_LT(store.fileSize(), raw);
+    }
+    std::remove(path.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(TestRejectsInconsistentHistory) {
+    std::vector<HistoricalCurve> history = syntheticHistory(3);
+    std::swap(history[0], history[1]);
+    BOOST_CHECK_THROW(CurveHistoryStore::write("unused.zchs", history), std::invalid_argument);
+    BOOST_CHECK_THROW(CurveHistoryStore("does_not_exist.zchs"), std::runtime_error);
+
+    // El fichero lleva una sola divisa en la cabecera
+    std::vector<HistoricalCurve> mixed = syntheticHistory(3);
+    mixed[2].currency = "USD";
+    BOOST_CHECK_THROW(CurveHistoryStore::write("unused.zchs", mixed), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(TestRejectsCorruptFiles) {
+    const std::string path = "test_corrupt_history.zchs";
+    CurveHistoryStore::write(path, syntheticHistory(100));
+    std::string original;
+    {
+        std::ifstream input(path, std::ios::binary);
+        original.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    }
+    auto rewrite = [&path](const std::string& bytes) {
+        std::ofstream output(path, std::ios::binary | std::ios::trunc);
+        output.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    };
+    auto setWord = [](std::string& bytes, std::size_t position, std::uint64_t value, std::size_t width) {
+        std::memcpy(&bytes[position], &value, width);
+    };
+
+    // Fichero truncado: falta la última parte de los datos
+    rewrite(original.substr(0, original.size() - 10));
+    BOOST_CHECK_THROW(CurveHistoryStore store(path), std::runtime_error);
+
+    // Cabecera con más filas de las que caben en el fichero
+    std::string rows = original;
+    setWord(rows, 8, 100000000, sizeof(std::uint32_t));
+    rewrite(rows);
+    BOOST_CHECK_THROW(CurveHistoryStore store(path), std::runtime_error);
+
+    // Offset de bloque fuera del fichero (primer offset del índice tras las fechas)
+    std::string offsets = original;
+    std::size_t index = 32 + ((100 * sizeof(std::int32_t) + 7) & ~std::size_t(7));
+    setWord(offsets, index + sizeof(std::uint64_t), std::uint64_t(1) << 40, sizeof(std::uint64_t));
+    rewrite(offsets);
+    BOOST_CHECK_THROW(CurveHistoryStore store(path), std::runtime_error);
+
+    // El original sigue abriéndose
+    rewrite(original);
+    BOOST_CHECK_NO_THROW(CurveHistoryStore store(path));
+    std::remove(path.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,106 @@
+#define BOOST_TEST_MODULE CurveKernelsTest
+#include <boost/test/unit_test.hpp>
+#include "../discount_curve.hpp"
+#include "../pricing_kernels.hpp"
+#include "../zero_coupon_curve.hpp"
+#include "../yield_curve.hpp"
+#include "../bond.hpp"
+#include "../swap.hpp"
+#include "../instrument_description.hpp"
+#include <cmath>
+#include <type_traits>
+
+static InstrumentDescription bondDescription() {
+    InstrumentDescription desc(InstrumentDescription::bond);
+    desc.maturity = 2.0;
+    desc.couponRate = 0.06;
+    desc.frequency = 2.0;
+    desc.notional = 100;
+    desc.issueDate = boost::gregorian::date(2024, 1, 1);
+    desc.couponDates = {0.5, 1.0, 1.5, 2.0};
+    desc.zeroCouponCurve = std::make_shared<ZeroCouponCurve>(
+        std::vector<double>{5.0, 5.8, 6.4, 6.8}, std::vector<double>{0.5, 1.0, 1.5, 2.0});
+    return desc;
+}
+
+BOOST_AUTO_TEST_SUITE(CurveKernelsSuite)
+
+BOOST_AUTO_TEST_CASE(TestPillarCurvesShareInterpolation) {
+    std::vector<double> maturities = {0.5, 1.0, 1.5, 2.0};
+    ZeroCouponCurve zeroCurve({5.0, 5.8, 6.4, 6.8}, maturities);
+
+    std::vector<double> discountFactors;
+    for (double t : maturities) discountFactors.push_back(zeroCurve.getDiscountFactor(t));
+    YieldCurve yieldCurve(discountFactors, maturities);
+
+    for (double t : {0.1, 0.5, 0.75, 1.2, 2.0, 3.0}) {
+        BOOST_CHECK_EQUAL(yieldCurve.getDiscountFactor(t), zeroCurve.getDiscountFactor(t));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestFlatCurveBondMatchesHandWritten) {
+    Bond bond(bondDescription());
+    FlatCurve flat(0.05);
+
+    // Versión escrita a mano: 4 cupones de 3 y el principal
+    double expected = 0.0;
+    for (double t : {0.5, 1.0, 1.5, 2.0}) expected += 3.0 * std::exp(-0.05 * t);
+    expected += 100.0 * std::exp(-0.05 * 2.0);
+
+    BOOST_CHECK_CLOSE(bond.presentValue(flat), expected, 1e-12);
+    BOOST_CHECK_CLOSE(bond.risk(flat).price, expected, 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(TestSpreadCurveOverBase) {
+    InstrumentDescription desc = bondDescription();
+    Bond bond(desc);
+    const ZeroCouponCurve& base = *desc.zeroCouponCurve;
+
+    BOOST_CHECK_CLOSE(bond.presentValue(makeSpreadCurve(base, 0.0)), bond.price(), 1e-10);
+
+    // Un spread sobre una curva plana equivale a una curva plana más alta
+    FlatCurve flat(0.04);
+    BOOST_CHECK_CLOSE(bond.presentValue(makeSpreadCurve(flat, 0.01)),
+                      bond.presentValue(FlatCurve(0.05)), 1e-12);
+
+    // Y una SpreadCurve sirve también como base de otra
+    auto spread = makeSpreadCurve(flat, 0.005);
+    BOOST_CHECK_CLOSE(bond.presentValue(makeSpreadCurve(spread, 0.005)),
+                      bond.presentValue(FlatCurve(0.05)), 1e-12);
+
+    // Sobre un temporal no compila: la referencia a la curva base quedaría colgando
+    static_assert(std::is_constructible<SpreadCurve<FlatCurve>, const FlatCurve&, double>::value,
+                  "SpreadCurve sobre una curva con nombre");
+    static_assert(!std::is_constructible<SpreadCurve<FlatCurve>, FlatCurve, double>::value,
+                  "SpreadCurve no debe aceptar una curva temporal");
+}
+
+BOOST_AUTO_TEST_CASE(TestNelsonSiegelSvensson) {
+    // Solo nivel: es una curva plana
+    NelsonSiegelSvenssonCurve level(0.03, 0.0, 0.0, 0.0, 1.5, 5.0);
+    BOOST_CHECK_CLOSE(level.getDiscountFactor(4.0), FlatCurve(0.03).getDiscountFactor(4.0), 1e-12);
+
+    // En t -> 0 la tasa tiende a b0 + b1; a largo plazo tiende a b0
+    NelsonSiegelSvenssonCurve curve(0.04, -0.02, 0.01, 0.005, 1.5, 5.0);
+    BOOST_CHECK_CLOSE(curve.zeroRate(1e-8), 0.02, 1e-4);
+    BOOST_CHECK_CLOSE(curve.zeroRate(1e4), 0.04, 0.1);
+
+    InstrumentDescription desc(InstrumentDescription::swap);
+    desc.notional = 100;
+    desc.fixedRate = 0.03;
+    desc.fixedFrequency = 1.0;
+    desc.floatingFrequency = 1.0;
+    desc.initialFixing = 0.02;
+    desc.floatingIndex = "Euribor12M";
+    desc.dayCountConvention = "ACT/360";
+    desc.issueDate = boost::gregorian::date(2024, 1, 1);
+    desc.maturity = 5.0;
+    Swap swap(desc);
+
+    SwapValuation v = swap.valuation(curve);
+    BOOST_CHECK_GT(v.annuity, 4.0);
+    BOOST_CHECK_LT(v.annuity, 5.1);
+    BOOST_CHECK_GT(v.parRate, 0.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
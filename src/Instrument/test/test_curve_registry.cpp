@@ -0,0 +1,119 @@
+#define BOOST_TEST_MODULE CurveRegistryTest
+#include <boost/test/unit_test.hpp>
+#include "../curve_registry.hpp"
+#include "../swap.hpp"
+#include "../instrument_description.hpp"
+#include "../factory.hpp"
+#include "../swap_builder.hpp"
+#include "../bond_builder.hpp"
+#include "../factory_registrator.hpp"
+#include "test_fixtures.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+static FactoryRegistrator<SwapBuilder> swapRegistrator;
+
+static std::shared_ptr<ZeroCouponCurve> flatCurve(double rate) {
+    return std::make_shared<ZeroCouponCurve>(
+        std::vector<double>(5, rate), std::vector<double>{1.0, 2.0, 3.0, 4.0, 5.0});
+}
+
+BOOST_AUTO_TEST_SUITE(CurveRegistrySuite)
+
+BOOST_AUTO_TEST_CASE(TestInternedIds) {
+    CurveRegistry registry;
+    auto estr = registry.intern("EUR-ESTR");
+    auto euribor = registry.intern("Euribor6M");
+
+    BOOST_CHECK_NE(estr, euribor);
+    BOOST_CHECK_EQUAL(registry.intern("EUR-ESTR"), estr);
+    BOOST_CHECK_EQUAL(registry.find("Euribor6M"), euribor);
+    BOOST_CHECK_EQUAL(registry.name(euribor), "Euribor6M");
+    BOOST_CHECK_THROW(registry.find("USD-SOFR"), std::invalid_argument);
+    BOOST_CHECK_THROW(registry.handle(estr), std::runtime_error);
+    BOOST_CHECK_THROW(registry.handle(99), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(TestInternWhilePricing) {
+    // Altas de curvas nuevas mientras otros hilos leen las ya publicadas
+    CurveRegistry registry;
+    auto id = registry.publish("EUR-ESTR", flatCurve(3.0));
+    double expected = flatCurve(3.0)->getDiscountFactor(2.0);
+
+    std::atomic<bool> done{false};
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r) {
+        readers.emplace_back([&]() {
+            while (!done.load()) {
+                CurveHandle::ReadGuard guard(registry.handle(id));
+                if (guard.curve().getDiscountFactor(2.0) != expected) ++mismatches;
+            }
+        });
+    }
+
+    auto curve = flatCurve(4.0);
+    for (int i = 0; i < 1000; ++i) registry.publish("CURVA-" + std::to_string(i), curve);
+    done = true;
+    for (auto& reader : readers) reader.join();
+
+    BOOST_CHECK_EQUAL(mismatches.load(), 0);
+    BOOST_CHECK_EQUAL(registry.size(), 1001u);
+    BOOST_CHECK_EQUAL(registry.find("CURVA-999"), 1000u);
+    BOOST_CHECK_EQUAL(registry.name(1000), "CURVA-999");
+    BOOST_CHECK_EQUAL(registry.find("EUR-ESTR"), id);
+}
+
+BOOST_AUTO_TEST_CASE(TestSwapProjectsOnIndexCurve) {
+    auto registry = std::make_shared<CurveRegistry>();
+    auto discount = flatCurve(3.0);
+    registry->publish("EUR-ESTR", discount);
+    registry->publish("Euribor6M", flatCurve(3.0));
+
+    InstrumentDescription desc = swapDescription(0.05, 3.0);
+    desc.curveRegistry = registry;
+    desc.discountCurve = "EUR-ESTR";
+    auto swap = Factory::instance()(desc);
+
+    // Con la misma curva en ambas patas coincide con la valoración monocurva
+    Swap* single = dynamic_cast<Swap*>(swap.get());
+    BOOST_REQUIRE(single != nullptr);
+    BOOST_CHECK_CLOSE(swap->price(), single->price(*discount), 1e-10);
+
+    // Subir la curva del índice encarece la pata flotante y baja el NPV del swap
+    double before = swap->price();
+    CurveStamp stamp = swap->curveStamp();
+    registry->publish("Euribor6M", flatCurve(3.5));
+    double after = swap->price();
+
+    BOOST_CHECK_LT(after, before);
+    BOOST_CHECK_EQUAL(swap->curveStamp()[0], stamp[0]);
+    BOOST_CHECK_NE(swap->curveStamp()[1], stamp[1]);
+}
+
+BOOST_AUTO_TEST_CASE(TestInvalidDescriptionDoesNotIntern) {
+    auto registry = std::make_shared<CurveRegistry>();
+
+    // Los builders validan antes de construir: un trade rechazado no deja nombres en el registro
+    InstrumentDescription bond = bondDescription(0.06);
+    bond.curveRegistry = registry;
+    bond.discountCurve = "EUR-ESTR";
+    bond.couponDates.clear();
+    BOOST_CHECK_THROW(BondBuilder::build(bond), std::invalid_argument);
+    BOOST_CHECK_THROW(BondBuilder::buildValue(bond), std::invalid_argument);
+
+    InstrumentDescription swap = swapDescription(0.05);
+    swap.curveRegistry = registry;
+    swap.discountCurve = "EUR-ESTR";
+    swap.dayCountConvention = "ACT/365";
+    BOOST_CHECK_THROW(SwapBuilder::build(swap), std::invalid_argument);
+    BOOST_CHECK_EQUAL(registry->size(), 0u);
+
+    bond.couponDates = {0.5, 1.0, 1.5, 2.0};
+    BondBuilder::build(bond);
+    BOOST_CHECK_EQUAL(registry->size(), 1u);
+    BOOST_CHECK_EQUAL(registry->find("EUR-ESTR"), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
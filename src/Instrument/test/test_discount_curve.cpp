@@ -135,4 +135,95 @@ BOOST_AUTO_TEST_CASE(TestEmptyCurveCalibration) {
     BOOST_CHECK_THROW(calibrator.calibrate(), std::runtime_error);
 }
 
+// Calibra 2 depósitos y 4 swaps con las cotizaciones dadas (en %)
+static std::shared_ptr<ZeroCouponCurve> calibrateQuotes(CurveCalibrator& calibrator, const std::vector<double>& quotes) {
+    calibrator.setVerbose(false);
+    calibrator.addDeposit(quotes[0], 3);
+    calibrator.addDeposit(quotes[1], 6);
+    calibrator.addSwap(quotes[2], 12);
+    calibrator.addSwap(quotes[3], 18);
+    calibrator.addSwap(quotes[4], 24);
+    calibrator.addSwap(quotes[5], 36);
+    return calibrator.calibrate();
+}
+
+BOOST_AUTO_TEST_CASE(TestQuoteJacobianMatchesRecalibration) {
+    boost::gregorian::date baseDate(2016, 4, 1);
+    std::vector<double> quotes = {4.8, 5.0, 5.5, 6.0, 6.4, 6.8};
+    const double bump = 1e-4;
+
+    for (InterpolationMethod method : {InterpolationMethod::Linear, InterpolationMethod::LogLinear}) {
+        CurveCalibrator calibrator(baseDate, method);
+        calibrateQuotes(calibrator, quotes);
+        const auto& jacobian = calibrator.zeroRateJacobian();
+        const auto& dfJacobian = calibrator.discountFactorJacobian();
+        BOOST_REQUIRE_EQUAL(jacobian.size(), quotes.size());
+
+        for (size_t j = 0; j < quotes.size(); ++j) {
+            std::vector<double> up = quotes, down = quotes;
+            up[j] += bump;
+            down[j] -= bump;
+            CurveCalibrator upCalibrator(baseDate, method), downCalibrator(baseDate, method);
+            auto upCurve = calibrateQuotes(upCalibrator, up);
+            auto downCurve = calibrateQuotes(downCalibrator, down);
+
+            for (size_t i = 0; i < quotes.size(); ++i) {
+                double zeroDerivative = (upCurve->getZeroRates()[i] - downCurve->getZeroRates()[i]) / (2 * bump);
+                double dfDerivative = (upCurve->getDiscountFactors()[i] - downCurve->getDiscountFactors()[i]) / (2 * bump);
+                BOOST_CHECK_SMALL(jacobian[i][j] - zeroDerivative, 1e-6);
+                BOOST_CHECK_SMALL(dfJacobian[i][j] - dfDerivative, 1e-8);
+            }
+        }
+        // Bootstrap: ningún pilar depende de cotizaciones más largas
+        BOOST_CHECK_EQUAL(jacobian[1][4], 0.0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestPillarRiskToQuoteRisk) {
+    boost::gregorian::date baseDate(2016, 4, 1);
+    std::vector<double> quotes = {4.8, 5.0, 5.5, 6.0, 6.4, 6.8};
+    CurveCalibrator calibrator(baseDate);
+    auto curve = calibrateQuotes(calibrator, quotes);
+
+    InstrumentDescription desc(InstrumentDescription::swap);
+    desc.notional = 1000000;
+    desc.fixedRate = 0.06;
+    desc.fixedFrequency = 2.0;
+    desc.floatingFrequency = 2.0;
+    desc.initialFixing = 0.05;
+    desc.floatingIndex = "Euribor6M";
+    desc.dayCountConvention = "ACT/360";
+    desc.issueDate = baseDate;
+    desc.maturity = 2.5;
+    desc.zeroCouponCurve = curve;
+    Swap swap(desc);
+
+    // Riesgo por pilar de tasa cero (en %), por diferencias centrales sobre la curva
+    const double bump = 1e-4;
+    std::vector<double> pillarRisk(quotes.size());
+    for (size_t i = 0; i < quotes.size(); ++i) {
+        std::vector<double> up = curve->getZeroRates(), down = curve->getZeroRates();
+        up[i] += bump;
+        down[i] -= bump;
+        ZeroCouponCurve upCurve(baseDate, up, curve->getDates());
+        ZeroCouponCurve downCurve(baseDate, down, curve->getDates());
+        pillarRisk[i] = (swap.npv(upCurve) - swap.npv(downCurve)) / (2 * bump);
+    }
+
+    std::vector<double> quoteRisk = calibrator.quoteRisk(pillarRisk);
+
+    // Referencia: recalibrar con cada cotización desplazada
+    for (size_t j = 0; j < quotes.size(); ++j) {
+        std::vector<double> up = quotes, down = quotes;
+        up[j] += bump;
+        down[j] -= bump;
+        CurveCalibrator upCalibrator(baseDate), downCalibrator(baseDate);
+        double expected = (swap.npv(*calibrateQuotes(upCalibrator, up))
+                           - swap.npv(*calibrateQuotes(downCalibrator, down))) / (2 * bump);
+        BOOST_CHECK_SMALL(quoteRisk[j] - expected, 1e-3);
+    }
+
+    BOOST_CHECK_THROW(calibrator.quoteRisk({1.0}), std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
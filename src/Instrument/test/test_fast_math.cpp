@@ -0,0 +1,160 @@
+#define BOOST_TEST_MODULE FastMathTest
+#include <boost/test/unit_test.hpp>
+#include "../fast_math.hpp"
+#include <random>
+#include <vector>
+#include <limits>
+#include <chrono>
+#include <cstdint>
+
+// Distancia en ulps entre dos doubles finitos del mismo signo
+static std::uint64_t ulpDistance(double a, double b) {
+    std::uint64_t x = fastmath::detail::toBits(a), y = fastmath::detail::toBits(b);
+    return x > y ? x - y : y - x;
+}
+
+static std::vector<double> uniform(double low, double high, size_t n, unsigned seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> dist(low, high);
+    std::vector<double> values(n);
+    for (double& v : values) v = dist(rng);
+    return values;
+}
+
+template<typename F>
+static double elapsedMs(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+BOOST_AUTO_TEST_SUITE(FastMathSuite)
+
+BOOST_AUTO_TEST_CASE(TestExpWithinOneUlp) {
+    // Rango de descuento habitual (-r t) y todo el dominio rápido
+    for (auto range : {std::make_pair(-5.0, 0.5), std::make_pair(-708.0, 709.0)}) {
+        std::uint64_t worst = 0;
+        for (double x : uniform(range.first, range.second, 200000, 1)) {
+            worst = std::max(worst, ulpDistance(fastmath::exp(x), std::exp(x)));
+        }
+        BOOST_CHECK_LE(worst, 1u);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestFastExpRelativeError) {
+    double worst = 0.0;
+    for (double x : uniform(-50.0, 50.0, 200000, 2)) {
+        double expected = std::exp(x);
+        worst = std::max(worst, std::abs(fastmath::exp<fastmath::Accuracy::Fast>(x) - expected) / expected);
+    }
+    BOOST_CHECK_LT(worst, 5e-13);
+    BOOST_TEST_MESSAGE("Error relativo máximo de exp<Fast>: " << worst);
+}
+
+BOOST_AUTO_TEST_CASE(TestLogWithinOneUlp) {
+    std::vector<std::vector<double>> ranges = {
+        uniform(0.5, 2.0, 200000, 3),        // Cerca de 1, donde importa la precisión relativa
+        uniform(1e-3, 1.0, 200000, 4),       // Factores de descuento
+        uniform(1e-300, 1e300, 200000, 5)};
+    for (const auto& values : ranges) {
+        std::uint64_t worst = 0;
+        for (double x : values) {
+            worst = std::max(worst, ulpDistance(fastmath::log(x), std::log(x)));
+        }
+        BOOST_CHECK_LE(worst, 1u);
+    }
+    BOOST_CHECK_EQUAL(fastmath::log(1.0), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(TestPowForYieldDiscounting) {
+    // (1 + y / f)^(t f) como en Bond::yieldToMaturity
+    double worst = 0.0;
+    std::mt19937_64 rng(6);
+    std::uniform_real_distribution<double> yields(-0.01, 0.15), times(0.0, 60.0);
+    for (int i = 0; i < 100000; ++i) {
+        double base = 1.0 + yields(rng) / 2.0, exponent = 2.0 * times(rng);
+        double expected = std::pow(base, exponent);
+        worst = std::max(worst, std::abs(fastmath::pow(base, exponent) - expected) / expected);
+    }
+    BOOST_CHECK_LT(worst, 1e-14);
+}
+
+BOOST_AUTO_TEST_CASE(TestSpecialValuesMatchLibm) {
+    const double inf = std::numeric_limits<double>::infinity();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    for (double x : {-1000.0, -745.0, -708.5, 709.5, 710.0, 1000.0, inf, -inf, 0.0, -0.0}) {
+        BOOST_CHECK_EQUAL(fastmath::exp(x), std::exp(x));
+    }
+    BOOST_CHECK(std::isnan(fastmath::exp(nan)));
+
+    for (double x : {0.0, 4.9e-324, 1e-310, inf}) {
+        BOOST_CHECK_EQUAL(fastmath::log(x), std::log(x));
+    }
+    BOOST_CHECK(std::isnan(fastmath::log(-1.0)));
+    BOOST_CHECK(std::isnan(fastmath::log(nan)));
+    BOOST_CHECK_EQUAL(fastmath::pow(0.0, 2.0), 0.0);
+    BOOST_CHECK_EQUAL(fastmath::pow(-2.0, 3.0), -8.0);
+}
+
+BOOST_AUTO_TEST_CASE(TestBatchMatchesScalar) {
+    // Tamaño que no es múltiplo del bloque y valores fuera del dominio rápido
+    std::vector<double> x = uniform(-20.0, 20.0, 1000, 7);
+    x[3] = -800.0;
+    x[500] = 800.0;
+    x[999] = std::numeric_limits<double>::quiet_NaN();
+
+    std::vector<double> out(x.size());
+    fastmath::exp(x.data(), out.data(), x.size());
+    for (size_t i = 0; i + 1 < x.size(); ++i) BOOST_CHECK_EQUAL(out[i], fastmath::exp(x[i]));
+    BOOST_CHECK(std::isnan(out.back()));
+
+    std::vector<double> positive = uniform(1e-6, 10.0, 1000, 8);
+    positive[10] = 0.0;
+    positive[20] = -1.0;
+    std::vector<double> logs(positive);
+    fastmath::log(logs.data(), logs.data(), logs.size());  // En el sitio
+    for (size_t i = 0; i < positive.size(); ++i) {
+        if (i == 20) BOOST_CHECK(std::isnan(logs[i]));
+        else BOOST_CHECK_EQUAL(logs[i], fastmath::log(positive[i]));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestBenchmark) {
+    std::vector<double> x = uniform(-5.0, 0.5, 1 << 16, 9);
+    std::vector<double> out(x.size());
+    double sink = 0.0;
+    const int rounds = 20;
+
+    double libmExp = elapsedMs([&] {
+        for (int r = 0; r < rounds; ++r)
+            for (size_t i = 0; i < x.size(); ++i) out[i] = std::exp(x[i]);
+    });
+    sink += out[7];
+    double batchExp = elapsedMs([&] {
+        for (int r = 0; r < rounds; ++r) fastmath::exp(x.data(), out.data(), x.size());
+    });
+    sink += out[7];
+    double batchFastExp = elapsedMs([&] {
+        for (int r = 0; r < rounds; ++r) fastmath::exp<fastmath::Accuracy::Fast>(x.data(), out.data(), x.size());
+    });
+    sink += out[7];
+
+    std::vector<double> dfs(out);
+    double libmLog = elapsedMs([&] {
+        for (int r = 0; r < rounds; ++r)
+            for (size_t i = 0; i < dfs.size(); ++i) out[i] = std::log(dfs[i]);
+    });
+    sink += out[7];
+    double batchLog = elapsedMs([&] {
+        for (int r = 0; r < rounds; ++r) fastmath::log(dfs.data(), out.data(), dfs.size());
+    });
+    sink += out[7];
+
+    BOOST_CHECK(std::isfinite(sink));
+    BOOST_TEST_MESSAGE("exp: libm " << libmExp << " ms, lote " << batchExp << " ms, lote Fast "
+                       << batchFastExp << " ms; log: libm " << libmLog << " ms, lote " << batchLog << " ms ("
+                       << rounds * x.size() << " evaluaciones)");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
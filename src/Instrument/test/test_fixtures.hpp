@@ -0,0 +1,57 @@
+#ifndef TEST_FIXTURES_HPP
+#define TEST_FIXTURES_HPP
+
+#include <memory>
+#include <utility>
+#include <vector>
+#include <boost/date_time/gregorian/gregorian.hpp>
+#include "../instrument_description.hpp"
+#include "../zero_coupon_curve.hpp"
+
+// Curva y trades de referencia compartidos por los tests
+
+// Fecha de la curva de prueba y de emisión de los trades
+inline const boost::gregorian::date kBaseDate(2016, 4, 1);
+
+// Curva cero a 6, 12, 18 y 24 meses (4.74% .. 5.20%), desplazada shift puntos
+inline std::shared_ptr<ZeroCouponCurve> testCurve(double shift = 0.0) {
+    return std::make_shared<ZeroCouponCurve>(
+        kBaseDate,
+        std::vector<double>{4.74 + shift, 5.00 + shift, 5.10 + shift, 5.20 + shift},
+        std::vector<boost::gregorian::date>{
+            boost::gregorian::date(2016, 10, 1), boost::gregorian::date(2017, 4, 1),
+            boost::gregorian::date(2017, 10, 1), boost::gregorian::date(2018, 4, 1)});
+}
+
+// Swap fijo contra Euribor6M, ambas patas semestrales, nominal 100.
+// Sin curva se valora por handle o por registro.
+inline InstrumentDescription swapDescription(double fixedRate, double maturity = 2.0,
+                                             std::shared_ptr<ZeroCouponCurve> curve = nullptr) {
+    InstrumentDescription desc(InstrumentDescription::swap);
+    desc.notional = 100;
+    desc.fixedRate = fixedRate;
+    desc.fixedFrequency = 2.0;
+    desc.floatingFrequency = 2.0;
+    desc.initialFixing = 0.048;
+    desc.floatingIndex = "Euribor6M";
+    desc.dayCountConvention = "ACT/360";
+    desc.issueDate = kBaseDate;
+    desc.maturity = maturity;
+    desc.zeroCouponCurve = std::move(curve);
+    return desc;
+}
+
+// Bono a 2 años con cupón semestral, nominal 100
+inline InstrumentDescription bondDescription(double couponRate, std::shared_ptr<ZeroCouponCurve> curve = nullptr) {
+    InstrumentDescription desc(InstrumentDescription::bond);
+    desc.maturity = 2.0;
+    desc.couponRate = couponRate;
+    desc.frequency = 2.0;
+    desc.notional = 100;
+    desc.issueDate = kBaseDate;
+    desc.couponDates = {0.5, 1.0, 1.5, 2.0};
+    desc.zeroCouponCurve = std::move(curve);
+    return desc;
+}
+
+#endif // TEST_FIXTURES_HPP
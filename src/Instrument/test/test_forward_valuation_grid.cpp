@@ -0,0 +1,147 @@
+#define BOOST_TEST_MODULE ForwardValuationGridTest
+#include <boost/test/unit_test.hpp>
+#include "../forward_valuation_grid.hpp"
+#include "../cashflow.hpp"
+#include "../bond.hpp"
+#include "../swap.hpp"
+#include "../instrument_description.hpp"
+#include "../zero_coupon_curve.hpp"
+#include "test_fixtures.hpp"
+#include <memory>
+#include <cmath>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(ForwardValuationGridSuite)
+
+static std::unique_ptr<Instrument> makeTrade(int i, std::shared_ptr<ZeroCouponCurve> curve) {
+    if (i % 2 == 0) {
+        InstrumentDescription desc(InstrumentDescription::bond);
+        desc.maturity = 2.0;
+        desc.couponRate = 0.04 + 0.001 * (i % 10);
+        desc.frequency = 2.0;
+        desc.notional = 100;
+        desc.issueDate = boost::gregorian::date(2016, 4, 1);
+        desc.couponDates = {0.5, 1.0, 1.5, 2.0};
+        desc.zeroCouponCurve = curve;
+        return std::make_unique<Bond>(desc);
+    }
+    InstrumentDescription desc(InstrumentDescription::swap);
+    desc.notional = 100;
+    desc.fixedRate = 0.045 + 0.0005 * (i % 10);
+    desc.fixedFrequency = 2.0;
+    desc.floatingFrequency = 2.0;
+    desc.initialFixing = 0.048;
+    desc.floatingIndex = "Euribor6M";
+    desc.dayCountConvention = "ACT/360";
+    desc.issueDate = boost::gregorian::date(2016, 4, 1);
+    desc.maturity = 2.0;
+    desc.zeroCouponCurve = curve;
+    return std::make_unique<Swap>(desc);
+}
+
+static std::vector<boost::gregorian::date> monthlyGrid(int months) {
+    std::vector<boost::gregorian::date> dates;
+    for (int m = 0; m <= months; ++m) {
+        dates.push_back(boost::gregorian::date(2016, 4, 1) + boost::gregorian::months(m));
+    }
+    return dates;
+}
+
+BOOST_AUTO_TEST_CASE(TestMatchesDirectForwardValue) {
+    auto curve = testCurve();
+    auto bond = makeTrade(0, curve);
+    auto swap = makeTrade(1, curve);
+    std::vector<const Instrument*> trades = {bond.get(), swap.get()};
+
+    ForwardValuationGrid grid(curve, monthlyGrid(30), 1);
+    std::vector<double> values = grid.compute(trades);
+    const size_t columns = grid.dates().size();
+    BOOST_REQUIRE_EQUAL(values.size(), 2 * columns);
+
+    // Hoy coincide con el precio del bono y el NPV del swap
+    BOOST_CHECK_CLOSE(values[0], static_cast<const Bond&>(*bond).price(), 1e-10);
+    BOOST_CHECK_CLOSE(values[columns], static_cast<const Swap&>(*swap).npv(*curve), 1e-10);
+
+    for (size_t t = 0; t < trades.size(); ++t) {
+        CashflowBuffer buffer;
+        trades[t]->cashflows(*curve, buffer);
+        for (size_t d = 0; d < columns; ++d) {
+            double h = grid.horizons()[d];
+            double expected = 0.0;
+            for (size_t i = 0; i < buffer.size(); ++i) {
+                if (buffer.time(i) > h) {
+                    expected += buffer.amount(i) * curve->getDiscountFactor(buffer.time(i));
+                }
+            }
+            expected /= curve->getDiscountFactor(h);
+            BOOST_CHECK_SMALL(values[t * columns + d] - expected, 1e-10);
+        }
+    }
+
+    // Tras el último flujo el valor es cero
+    BOOST_CHECK_EQUAL(values[columns - 1], 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(TestForwardInsideFirstPillarInterval) {
+    // Curva plana al 5% con el primer pilar a 183 días; cupones trimestrales
+    auto curve = std::make_shared<ZeroCouponCurve>(
+        boost::gregorian::date(2016, 4, 1), std::vector<double>{5.0, 5.0},
+        std::vector<boost::gregorian::date>{boost::gregorian::date(2016, 10, 1),
+                                            boost::gregorian::date(2017, 4, 1)});
+    InstrumentDescription desc(InstrumentDescription::bond);
+    desc.maturity = 0.5;
+    desc.couponRate = 0.05;
+    desc.frequency = 4.0;
+    desc.notional = 100;
+    desc.issueDate = boost::gregorian::date(2016, 4, 1);
+    desc.couponDates = {0.25, 0.5};
+    desc.zeroCouponCurve = curve;
+    Bond bond(desc);
+    bond.setVerbose(false);
+
+    // Horizonte a 36 días: fecha y primer cupón dentro de [0, t_1)
+    ForwardValuationGrid grid(curve, {boost::gregorian::date(2016, 5, 7)}, 1);
+    double h = grid.horizons()[0];
+    BOOST_REQUIRE_CLOSE(h, 0.1, 1e-12);
+    std::vector<double> values = grid.compute({&bond});
+
+    CashflowBuffer buffer;
+    bond.cashflows(*curve, buffer);
+    BOOST_REQUIRE_EQUAL(buffer.time(0), 0.25);
+    double expected = 0.0;
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        expected += buffer.amount(i) * curve->getDiscountFactor(buffer.time(i));
+    }
+    expected /= curve->getDiscountFactor(h);
+    BOOST_CHECK_CLOSE(values[0], expected, 1e-12);
+
+    // El DF forward de h a 0.25 implica un tipo cercano al 5% de la curva
+    double forwardDf = curve->getDiscountFactor(0.25) / curve->getDiscountFactor(h);
+    double forwardRate = -std::log(forwardDf) / (0.25 - h);
+    BOOST_CHECK_CLOSE(forwardRate, 0.05, 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(TestParallelMatchesSerial) {
+    auto curve = testCurve();
+    std::vector<std::unique_ptr<Instrument>> book;
+    std::vector<const Instrument*> trades;
+    for (int i = 0; i < 500; ++i) {
+        book.push_back(makeTrade(i, curve));
+        trades.push_back(book.back().get());
+    }
+
+    ForwardValuationGrid serial(curve, monthlyGrid(24), 1);
+    ForwardValuationGrid parallel(curve, monthlyGrid(24), 4);
+    BOOST_CHECK(serial.compute(trades) == parallel.compute(trades));
+}
+
+BOOST_AUTO_TEST_CASE(TestRejectsUnorderedGrid) {
+    auto curve = testCurve();
+    std::vector<boost::gregorian::date> dates = {
+        boost::gregorian::date(2016, 6, 1), boost::gregorian::date(2016, 5, 1)};
+    BOOST_CHECK_THROW(ForwardValuationGrid(curve, dates), std::invalid_argument);
+    BOOST_CHECK_THROW(ForwardValuationGrid(curve, {boost::gregorian::date(2016, 1, 1)}),
+                      std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
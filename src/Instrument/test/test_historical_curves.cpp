@@ -0,0 +1,77 @@
+#define BOOST_TEST_MODULE HistoricalCurvesTest
+#include <boost/test/unit_test.hpp>
+#include "../historical_curve_builder.hpp"
+#include <sstream>
+#include <string>
+
+// Histórico sintético: mismo esquema de cotizaciones del ejercicio, desplazado cada día
+static std::string syntheticQuotes(int days, const std::vector<std::string>& currencies) {
+    std::ostringstream out;
+    out << "date,currency,type,months,rate\n";
+    boost::gregorian::date start(2016, 4, 1);
+    for (int d = 0; d < days; ++d) {
+        std::string date = boost::gregorian::to_iso_extended_string(start + boost::gregorian::days(d));
+        for (size_t c = 0; c < currencies.size(); ++c) {
+            double shift = 0.01 * d + 0.1 * c;
+            out << date << ',' << currencies[c] << ",DEPOSIT,6," << 5.0 + shift << '\n'
+                << date << ',' << currencies[c] << ",SWAP,12," << 5.5 + shift << '\n'
+                << date << ',' << currencies[c] << ",SWAP,18," << 6.0 + shift << '\n'
+                << date << ',' << currencies[c] << ",SWAP,24," << 6.4 + shift << ",2\n";
+        }
+    }
+    return out.str();
+}
+
+BOOST_AUTO_TEST_SUITE(HistoricalCurvesSuite)
+
+BOOST_AUTO_TEST_CASE(TestReadQuotes) {
+    std::istringstream input(syntheticQuotes(3, {"EUR", "USD"}));
+    std::vector<QuoteSet> quoteSets = HistoricalCurveBuilder::readQuotes(input);
+
+    BOOST_REQUIRE_EQUAL(quoteSets.size(), 6u);
+    BOOST_CHECK_EQUAL(quoteSets[1].currency, "USD");
+    BOOST_CHECK_EQUAL(quoteSets[2].date, boost::gregorian::date(2016, 4, 2));
+    BOOST_REQUIRE_EQUAL(quoteSets[0].quotes.size(), 4u);
+    BOOST_CHECK_EQUAL(quoteSets[0].quotes[0].kind, CurveQuote::deposit);
+    BOOST_CHECK_EQUAL(quoteSets[0].quotes[3].months, 24);
+
+    std::istringstream bad("2016-04-01,EUR,FRA,6,5.0\n");
+    BOOST_CHECK_THROW(HistoricalCurveBuilder::readQuotes(bad), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(TestParallelBuildMatchesSequential) {
+    std::istringstream input(syntheticQuotes(40, {"EUR", "USD", "GBP"}));
+    std::vector<QuoteSet> quoteSets = HistoricalCurveBuilder::readQuotes(input);
+
+    std::vector<HistoricalCurve> parallel = HistoricalCurveBuilder(4).build(quoteSets);
+    std::vector<HistoricalCurve> sequential = HistoricalCurveBuilder(1).build(quoteSets);
+
+    BOOST_REQUIRE_EQUAL(parallel.size(), quoteSets.size());
+    for (size_t i = 0; i < parallel.size(); ++i) {
+        BOOST_CHECK_EQUAL(parallel[i].date, quoteSets[i].date);
+        BOOST_CHECK_EQUAL(parallel[i].currency, quoteSets[i].currency);
+        BOOST_CHECK(parallel[i].curve->getDiscountFactors() == sequential[i].curve->getDiscountFactors());
+    }
+
+    // Primer día EUR: mismas cotizaciones que el ejercicio de calibración
+    const ZeroCouponCurve& first = *parallel[0].curve;
+    BOOST_CHECK_CLOSE(first.getDiscountFactors()[0], 0.975213, 0.1);
+    BOOST_CHECK_CLOSE(first.getDiscountFactors()[3], 0.879470, 0.1);
+}
+
+BOOST_AUTO_TEST_CASE(TestWriteCurves) {
+    std::istringstream input(syntheticQuotes(2, {"EUR"}));
+    std::vector<HistoricalCurve> curves = HistoricalCurveBuilder(2).build(HistoricalCurveBuilder::readQuotes(input));
+
+    std::ostringstream output;
+    HistoricalCurveBuilder::writeCurves(output, curves);
+
+    std::istringstream lines(output.str());
+    std::string line;
+    int count = 0;
+    while (std::getline(lines, line)) ++count;
+    BOOST_CHECK_EQUAL(count, 1 + 2 * 4);
+    BOOST_CHECK(output.str().find("2016-04-02,EUR,2016-10-02,") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
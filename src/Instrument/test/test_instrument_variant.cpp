@@ -0,0 +1,96 @@
+#define BOOST_TEST_MODULE InstrumentVariantTest
+#include <boost/test/unit_test.hpp>
+#include "../instrument_variant.hpp"
+#include "../factory.hpp"
+#include "../factory_registrator.hpp"
+#include "test_fixtures.hpp"
+#include <chrono>
+
+static FactoryRegistrator<BondBuilder> bondRegistrator;
+static FactoryRegistrator<SwapBuilder> swapRegistrator;
+
+// Libro mixto: bonos y swaps intercalados
+static std::vector<InstrumentDescription> mixedBook(size_t n) {
+    std::vector<InstrumentDescription> descriptions;
+    for (size_t i = 0; i < n; ++i) {
+        double rate = 0.04 + 0.0001 * static_cast<double>(i % 50);
+        descriptions.push_back(i % 3 == 0 ? swapDescription(rate, 2.0, testCurve(-0.1)) : bondDescription(rate, testCurve(0.2)));
+    }
+    return descriptions;
+}
+
+BOOST_AUTO_TEST_SUITE(InstrumentVariantSuite)
+
+BOOST_AUTO_TEST_CASE(TestMakeInstrumentPicksBuilder) {
+    InstrumentVariant bond = makeInstrument(bondDescription(0.05, testCurve(0.2)));
+    InstrumentVariant swap = makeInstrument(swapDescription(0.05, 2.0, testCurve(-0.1)));
+    BOOST_CHECK(std::holds_alternative<Bond>(bond));
+    BOOST_CHECK(std::holds_alternative<Swap>(swap));
+
+    // Mismas validaciones que la factoría
+    InstrumentDescription invalid = swapDescription(0.05, 2.0, testCurve(-0.1));
+    invalid.dayCountConvention = "ACT/365";
+    BOOST_CHECK_THROW(makeInstrument(invalid), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(TestBookMatchesVirtualPricing) {
+    std::vector<InstrumentDescription> descriptions = mixedBook(30);
+
+    InstrumentBook book;
+    std::vector<std::unique_ptr<Instrument>> pointers;
+    for (size_t i = 0; i < descriptions.size(); ++i) {
+        BOOST_CHECK_EQUAL(book.add(descriptions[i]), i);
+        pointers.push_back(Factory::instance()(descriptions[i]));
+        pointers.back()->setVerbose(false);
+    }
+    BOOST_CHECK_EQUAL(book.size(), descriptions.size());
+    BOOST_CHECK_EQUAL(book.instruments<Swap>().size(), 10u);
+    BOOST_CHECK_EQUAL(book.instruments<Bond>().size(), 20u);
+    BOOST_CHECK(!book.instruments<Bond>().front().verbose());
+
+    // Resultados en orden de inserción, idénticos a la valoración virtual
+    std::vector<double> own, common;
+    book.price(own);
+    auto curve = testCurve();
+    book.price(*curve, common);
+    BOOST_REQUIRE_EQUAL(own.size(), pointers.size());
+    for (size_t i = 0; i < pointers.size(); ++i) {
+        BOOST_CHECK_EQUAL(own[i], pointers[i]->price());
+        double expected = descriptions[i].type == InstrumentDescription::bond
+            ? dynamic_cast<const Bond&>(*pointers[i]).price(*curve)
+            : dynamic_cast<const Swap&>(*pointers[i]).price(*curve);
+        BOOST_CHECK_EQUAL(common[i], expected);
+    }
+
+    size_t visited = 0;
+    book.forEach([&visited](const auto&, size_t) { ++visited; });
+    BOOST_CHECK_EQUAL(visited, book.size());
+}
+
+BOOST_AUTO_TEST_CASE(TestBulkPricingTiming) {
+    std::vector<InstrumentDescription> descriptions = mixedBook(20000);
+    InstrumentBook book;
+    std::vector<std::unique_ptr<Instrument>> pointers;
+    for (const auto& desc : descriptions) {
+        book.add(desc);
+        pointers.push_back(Factory::instance()(desc));
+        pointers.back()->setVerbose(false);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<double> virtualResults(pointers.size());
+    for (size_t i = 0; i < pointers.size(); ++i) virtualResults[i] = pointers[i]->price();
+    auto middle = std::chrono::steady_clock::now();
+    std::vector<double> bookResults;
+    book.price(bookResults);
+    auto end = std::chrono::steady_clock::now();
+
+    BOOST_CHECK(bookResults == virtualResults);
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    double virtualMs = Milliseconds(middle - start).count();
+    double bookMs = Milliseconds(end - middle).count();
+    BOOST_TEST_MESSAGE("Valoración de " << pointers.size() << " instrumentos: virtual "
+                       << virtualMs << " ms, libro " << bookMs << " ms");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
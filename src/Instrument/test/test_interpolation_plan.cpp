@@ -0,0 +1,82 @@
+#define BOOST_TEST_MODULE InterpolationPlanTest
+#include <boost/test/unit_test.hpp>
+#include "../interpolation_plan.hpp"
+#include "../zero_coupon_curve.hpp"
+#include "../pricing_kernels.hpp"
+#include "../cashflow.hpp"
+#include "../swap.hpp"
+#include "../instrument_description.hpp"
+#include "test_fixtures.hpp"
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(InterpolationPlanSuite)
+
+BOOST_AUTO_TEST_CASE(TestPlanMatchesCurveLookup) {
+    ZeroCouponCurve curve({5.0, 5.8, 6.4, 6.8}, {0.5, 1.0, 1.5, 2.0});
+    std::vector<double> times = {0.1, 0.5, 0.75, 1.2, 1.5, 1.99, 2.0, 3.5};
+
+    InterpolationPlan plan(curve.getMaturities(), times);
+    BOOST_CHECK_EQUAL(plan.size(), times.size());
+    BOOST_CHECK_EQUAL(plan.pillars(), 4u);
+
+    std::vector<double> values;
+    plan.evaluate(curve.getDiscountFactors(), values);
+    for (size_t i = 0; i < times.size(); ++i) {
+        BOOST_CHECK_CLOSE(values[i], curve.getDiscountFactor(times[i]), 1e-12);
+    }
+
+    // Antes del primer pilar: desde DF(0) = 1, un solo pilar con peso t / t_1
+    BOOST_CHECK_EQUAL(plan.lowerPillar(0), plan.upperPillar(0));
+    BOOST_CHECK_CLOSE(plan.lowerWeight(0), 0.2, 1e-12);
+    BOOST_CHECK_CLOSE(plan.constant(0), 0.8, 1e-12);
+
+    // Extrapolación plana tras el último: un solo pilar con peso 1
+    BOOST_CHECK_EQUAL(plan.lowerPillar(7), 3u);
+    BOOST_CHECK_EQUAL(plan.upperPillar(7), 3u);
+    BOOST_CHECK_EQUAL(plan.lowerWeight(7), 1.0);
+    BOOST_CHECK_EQUAL(plan.constant(7), 0.0);
+
+    // Mismo plan tras republicar la curva con otras tasas
+    curve.updateZeroRates({4.0, 4.5, 5.0, 5.5});
+    plan.evaluate(curve.getDiscountFactors(), values);
+    for (size_t i = 0; i < times.size(); ++i) {
+        BOOST_CHECK_CLOSE(values[i], curve.getDiscountFactor(times[i]), 1e-12);
+    }
+
+    BOOST_CHECK_THROW(plan.evaluate(std::vector<double>{1.0, 0.9}, values), std::invalid_argument);
+    BOOST_CHECK_THROW(plan.weightedSum(curve.getDiscountFactors(), std::vector<double>(times.size() - 1, 1.0)),
+                      std::invalid_argument);
+    BOOST_CHECK_THROW(InterpolationPlan({}, times), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(TestWeightedSumMatchesDiscountedCashflows) {
+    auto curve = testCurve();
+
+    InstrumentDescription desc(InstrumentDescription::swap);
+    desc.notional = 100;
+    desc.fixedRate = 0.05;
+    desc.fixedFrequency = 4.0;
+    desc.floatingFrequency = 4.0;
+    desc.initialFixing = 0.048;
+    desc.floatingIndex = "Euribor3M";
+    desc.dayCountConvention = "ACT/360";
+    desc.issueDate = boost::gregorian::date(2016, 4, 1);
+    desc.maturity = 2.0;
+    desc.zeroCouponCurve = curve;
+    Swap swap(desc);
+
+    CashflowBuffer buffer;
+    swap.cashflows(*curve, buffer);
+    InterpolationPlan plan(curve->getMaturities(), buffer.times());
+
+    // Escenarios: mismas fechas, tasas desplazadas
+    for (double shift : {-1.0, 0.0, 0.5, 2.0}) {
+        std::vector<double> rates = curve->getZeroRates();
+        for (double& rate : rates) rate += shift;
+        ZeroCouponCurve scenario(curve->getIssueDate(), rates, curve->getDates());
+        BOOST_CHECK_CLOSE(plan.weightedSum(scenario.getDiscountFactors(), buffer.amounts()),
+                          discountCashflows(scenario, buffer), 1e-10);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
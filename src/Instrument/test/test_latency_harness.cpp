@@ -0,0 +1,181 @@
+#define BOOST_TEST_MODULE LatencyHarnessTest
+#include <boost/test/unit_test.hpp>
+#include "../latency_harness.hpp"
+#include "test_fixtures.hpp"
+#include <random>
+#include <sstream>
+#include <chrono>
+#include <sched.h>
+
+// Desordenadas a propósito: el arnés las ordena por vencimiento
+static std::vector<CurveQuote> testQuotes() {
+    return {{CurveQuote::swap, 24, 6.4}, {CurveQuote::deposit, 6, 5.0}, {CurveQuote::swap, 12, 5.5},
+            {CurveQuote::swap, 36, 6.6}, {CurveQuote::swap, 18, 6.0}};
+}
+
+static void addBook(TickReplayHarness& harness, size_t trades) {
+    for (size_t i = 0; i < trades; ++i) {
+        double rate = 0.04 + 0.0001 * static_cast<double>(i % 50);
+        if (i % 3 == 0) harness.add(bondDescription(rate, testCurve()));
+        else harness.add(swapDescription(rate, i % 2 == 0 ? 2.0 : 3.0, testCurve()));
+    }
+}
+
+// Ticks de ±1pb alrededor de las cotizaciones iniciales, cada spacing ns
+static std::vector<QuoteTick> randomTicks(const std::vector<CurveQuote>& quotes, size_t n,
+                                          std::uint64_t spacing, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<size_t> pillar(0, quotes.size() - 1);
+    std::uniform_int_distribution<int> move(-1, 1);
+    std::vector<double> rates;
+    for (const auto& quote : quotes) rates.push_back(quote.rate);
+
+    std::vector<QuoteTick> ticks;
+    for (size_t i = 0; i < n; ++i) {
+        size_t p = pillar(rng);
+        rates[p] += 0.01 * move(rng);
+        ticks.push_back(QuoteTick{i * spacing, p, rates[p]});
+    }
+    return ticks;
+}
+
+BOOST_AUTO_TEST_SUITE(LatencyHarnessSuite)
+
+BOOST_AUTO_TEST_CASE(TestHistogramPercentiles) {
+    LatencyHistogram histogram;
+    BOOST_CHECK_EQUAL(histogram.percentile(50.0), 0u);
+
+    for (std::uint64_t v = 1; v <= 100000; ++v) histogram.record(v);
+    BOOST_CHECK_EQUAL(histogram.count(), 100000u);
+    BOOST_CHECK_EQUAL(histogram.min(), 1u);
+    BOOST_CHECK_EQUAL(histogram.max(), 100000u);
+    BOOST_CHECK_CLOSE(histogram.mean(), 50000.5, 1e-9);
+    BOOST_CHECK_EQUAL(histogram.percentile(100.0), 100000u);
+
+    // Resolución de 1/128 por encima del tramo exacto
+    for (double p : {50.0, 90.0, 99.0, 99.9}) {
+        double exact = p / 100.0 * 100000.0;
+        double value = static_cast<double>(histogram.percentile(p));
+        BOOST_CHECK_GE(value, exact);
+        BOOST_CHECK_LE(value, exact * (1.0 + 1.0 / 128));
+    }
+
+    // Valores pequeños exactos y extremos de uint64 representables
+    LatencyHistogram small;
+    for (std::uint64_t v : {3u, 5u, 7u, 9u}) small.record(v);
+    BOOST_CHECK_EQUAL(small.percentile(50.0), 5u);
+    BOOST_CHECK_EQUAL(small.percentile(75.0), 7u);
+    small.record(~std::uint64_t(0));
+    BOOST_CHECK_EQUAL(small.percentile(100.0), ~std::uint64_t(0));
+
+    small.merge(histogram);
+    BOOST_CHECK_EQUAL(small.count(), 100005u);
+    BOOST_CHECK_EQUAL(small.min(), 1u);
+    small.reset();
+    BOOST_CHECK_EQUAL(small.count(), 0u);
+    BOOST_CHECK_EQUAL(small.max(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(TestReplayMatchesFreshCalibration) {
+    TickReplayHarness harness(kBaseDate, testQuotes());
+    addBook(harness, 60);
+    BOOST_CHECK_EQUAL(harness.quotes().front().months, 6);
+    BOOST_CHECK_EQUAL(harness.quotes().back().months, 36);
+
+    std::vector<QuoteTick> ticks = randomTicks(harness.quotes(), 500, 0, 1);
+    ReplayOptions options;
+    options.warmupTicks = 100;
+    LatencyReport report = harness.replay(ticks, options);
+    BOOST_CHECK_EQUAL(report.ticks, 400u);
+    BOOST_CHECK_EQUAL(report.tickToPrice.count(), 400u);
+    BOOST_CHECK_GE(report.tickToPrice.max(), report.pricing.max());
+
+    // Curva y valores tras el último tick = calibración desde cero con las últimas cotizaciones
+    std::vector<CurveQuote> finalQuotes = harness.quotes();
+    for (const QuoteTick& tick : ticks) finalQuotes[tick.pillar].rate = tick.rate;
+    CurveCalibrator calibrator(kBaseDate);
+    calibrator.setVerbose(false);
+    for (const auto& quote : finalQuotes) {
+        if (quote.kind == CurveQuote::deposit) calibrator.addDeposit(quote.rate, quote.months);
+        else calibrator.addSwap(quote.rate, quote.months, quote.fixedFrequency);
+    }
+    auto expectedCurve = calibrator.calibrate();
+    std::vector<double> expected;
+    harness.book().price(*expectedCurve, expected);
+
+    BOOST_REQUIRE_EQUAL(harness.values().size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) BOOST_CHECK_CLOSE(harness.values()[i], expected[i], 1e-10);
+
+    std::ostringstream table;
+    report.print(table);
+    BOOST_CHECK(table.str().find("p99.9") != std::string::npos);
+    BOOST_TEST_MESSAGE(table.str());
+}
+
+BOOST_AUTO_TEST_CASE(TestPacedReplayWithPinning) {
+    TickReplayHarness harness(kBaseDate, testQuotes());
+    addBook(harness, 20);
+    std::vector<QuoteTick> ticks = randomTicks(harness.quotes(), 50, 200000, 2);   // Un tick cada 200 us
+
+    // Primer núcleo permitido al proceso
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    BOOST_REQUIRE_EQUAL(sched_getaffinity(0, sizeof(allowed), &allowed), 0);
+    int cpu = 0;
+    while (!CPU_ISSET(cpu, &allowed)) ++cpu;
+
+    ReplayOptions options;
+    options.paced = true;
+    options.cpu = cpu;
+    auto start = std::chrono::steady_clock::now();
+    LatencyReport report = harness.replay(ticks, options);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    BOOST_CHECK_EQUAL(report.ticks, ticks.size());
+    BOOST_CHECK(elapsed >= std::chrono::nanoseconds(ticks.back().offset));
+    BOOST_TEST_MESSAGE("p99 tick->precio con ritmo grabado: " << report.tickToPrice.percentile(99.0) << " ns");
+
+    options.cpu = CPU_SETSIZE;
+    BOOST_CHECK_THROW(harness.replay(ticks, options), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(TestPhasesExcludeQueueing) {
+    TickReplayHarness harness(kBaseDate, testQuotes());
+    addBook(harness, 20);
+
+    // Todos los ticks llegan a la vez: cada uno espera en cola a los anteriores.
+    // La espera cuenta en tick -> precio pero no en las fases
+    std::vector<QuoteTick> ticks = randomTicks(harness.quotes(), 100, 0, 3);
+    ReplayOptions options;
+    options.paced = true;
+    LatencyReport report = harness.replay(ticks, options);
+
+    BOOST_CHECK_EQUAL(report.calibration.count(), ticks.size());
+    BOOST_CHECK_LT(report.calibration.mean() + report.pricing.mean(), report.tickToPrice.mean() / 4.0);
+}
+
+BOOST_AUTO_TEST_CASE(TestReadTicksAndInvalidInput) {
+    std::istringstream input("offset_us,pillar,rate\n"
+                             "# apertura\n"
+                             "0,1,5.51\n"
+                             "12.5,4,6.62\n"
+                             "40,0,4.99\n");
+    std::vector<QuoteTick> ticks = TickReplayHarness::readTicks(input);
+    BOOST_REQUIRE_EQUAL(ticks.size(), 3u);
+    BOOST_CHECK_EQUAL(ticks[1].offset, 12500u);
+    BOOST_CHECK_EQUAL(ticks[1].pillar, 4u);
+    BOOST_CHECK_EQUAL(ticks[1].rate, 6.62);
+
+    std::istringstream unordered("10,1,5.5\n5,1,5.6\n");
+    BOOST_CHECK_THROW(TickReplayHarness::readTicks(unordered), std::invalid_argument);
+    std::istringstream shortLine("10,1\n");
+    BOOST_CHECK_THROW(TickReplayHarness::readTicks(shortLine), std::invalid_argument);
+    BOOST_CHECK_THROW(TickReplayHarness::readTicks("does_not_exist.csv"), std::runtime_error);
+
+    TickReplayHarness harness(kBaseDate, testQuotes());
+    BOOST_CHECK_THROW(harness.replay({QuoteTick{0, 5, 5.0}}), std::invalid_argument);
+    BOOST_CHECK_THROW(harness.replay({QuoteTick{10, 0, 5.0}, QuoteTick{5, 0, 5.0}}), std::invalid_argument);
+    BOOST_CHECK_THROW(TickReplayHarness(kBaseDate, {}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
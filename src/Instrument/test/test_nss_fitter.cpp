@@ -0,0 +1,94 @@
+#define BOOST_TEST_MODULE NssFitterTest
+#include <boost/test/unit_test.hpp>
+#include "../nss_fitter.hpp"
+#include "../bond.hpp"
+#include "../discount_curve.hpp"
+#include "../instrument_description.hpp"
+#include <chrono>
+#include <memory>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(NssFitterSuite)
+
+static std::unique_ptr<Bond> makeBond(int i) {
+    InstrumentDescription desc(InstrumentDescription::bond);
+    int halfYears = 1 + (i * 7) % 60;   // de 6 meses a 30 años
+    desc.maturity = 0.5 * halfYears;
+    desc.couponRate = 0.01 + 0.0025 * (i % 20);
+    desc.frequency = 2.0;
+    desc.notional = 100;
+    desc.issueDate = boost::gregorian::date(2024, 1, 1);
+    for (int k = 1; k <= halfYears; ++k) desc.couponDates.push_back(0.5 * k);
+    desc.zeroCouponCurve = std::make_shared<ZeroCouponCurve>(std::vector<double>{3.0}, std::vector<double>{1.0});
+    return std::make_unique<Bond>(desc);
+}
+
+BOOST_AUTO_TEST_CASE(TestAnalyticGradient) {
+    NelsonSiegelSvenssonCurve curve(0.04, -0.02, 0.015, -0.01, 1.5, 7.0);
+    double params[6] = {0.04, -0.02, 0.015, -0.01, 1.5, 7.0};
+    const double h = 1e-7;
+    for (double t : {0.25, 1.0, 5.0, 30.0}) {
+        double gradient[6];
+        curve.zeroRateGradient(t, gradient);
+        for (int j = 0; j < 6; ++j) {
+            double up[6], down[6];
+            std::copy(params, params + 6, up);
+            std::copy(params, params + 6, down);
+            up[j] += h;
+            down[j] -= h;
+            double numeric = (NelsonSiegelSvenssonCurve(up[0], up[1], up[2], up[3], up[4], up[5]).zeroRate(t)
+                            - NelsonSiegelSvenssonCurve(down[0], down[1], down[2], down[3], down[4], down[5]).zeroRate(t))
+                           / (2 * h);
+            BOOST_CHECK_SMALL(gradient[j] - numeric, 1e-8);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestRecoversCurveFromBondPrices) {
+    NelsonSiegelSvenssonCurve truth(0.045, -0.02, 0.01, -0.008, 1.5, 8.0);
+
+    std::vector<std::unique_ptr<Bond>> book;
+    std::vector<const Bond*> bonds;
+    std::vector<double> prices;
+    for (int i = 0; i < 200; ++i) {
+        book.push_back(makeBond(i));
+        bonds.push_back(book.back().get());
+        prices.push_back(book.back()->presentValue(truth));
+    }
+
+    NssFitter fitter;
+    auto start = std::chrono::steady_clock::now();
+    NssFit fit = fitter.fit(bonds, prices);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    BOOST_TEST_MESSAGE("Ajuste NSS de 200 bonos: " << ms << " ms, " << fit.iterations
+                       << " iteraciones, rmse " << fit.rmse);
+
+    BOOST_CHECK(fit.converged);
+    BOOST_CHECK_SMALL(fit.rmse, 1e-6);
+    for (double t : {0.5, 1.0, 2.0, 5.0, 10.0, 20.0, 30.0}) {
+        BOOST_CHECK_SMALL(fit.curve.zeroRate(t) - truth.zeroRate(t), 1e-6);
+    }
+
+    // Mismo resultado con un solo hilo
+    NssFit serial = NssFitter(1).fit(bonds, prices);
+    BOOST_CHECK_EQUAL(serial.start, fit.start);
+    BOOST_CHECK_EQUAL(serial.rmse, fit.rmse);
+
+    // La curva ajustada se usa como cualquier otra
+    auto sampled = NssFitter::toZeroCouponCurve(fit.curve, {0.5, 1.0, 2.0, 5.0, 10.0, 20.0, 30.0});
+    BOOST_CHECK_CLOSE(sampled->getDiscountFactor(10.0), truth.getDiscountFactor(10.0), 1e-4);
+}
+
+BOOST_AUTO_TEST_CASE(TestInvalidInputs) {
+    auto bond = makeBond(1);
+    NssFitter fitter(1);
+    BOOST_CHECK_THROW(fitter.fit({}, {}), std::invalid_argument);
+    BOOST_CHECK_THROW(fitter.fit({bond.get()}, {100.0, 99.0}), std::invalid_argument);
+    BOOST_CHECK_THROW(fitter.fit({bond.get()}, {100.0}, {1.0, 1.0}), std::invalid_argument);
+
+    // Un bono sin flujos no tiene vencimiento con el que arrancar el ajuste
+    Bond empty;
+    BOOST_CHECK_THROW(fitter.fit({bond.get(), &empty}, {100.0, 100.0}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,51 @@
+#define BOOST_TEST_MODULE ParallelForTest
+#include <boost/test/unit_test.hpp>
+#include "../parallel_for.hpp"
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(ParallelForSuite)
+
+BOOST_AUTO_TEST_CASE(TestEveryIndexRunsOnce) {
+    for (unsigned threads : {0u, 1u, 4u, 64u}) {
+        std::vector<int> hits(1000, 0);
+        parallelFor(hits.size(), threads, [&hits](std::size_t i) { ++hits[i]; });
+        BOOST_CHECK(std::all_of(hits.begin(), hits.end(), [](int h) { return h == 1; }));
+    }
+    bool called = false;
+    parallelFor(0, 4, [&called](std::size_t) { called = true; });
+    BOOST_CHECK(!called);
+}
+
+BOOST_AUTO_TEST_CASE(TestStatePerThread) {
+    // Cada hilo reutiliza su estado: tantos estados como hilos, no como trabajos
+    struct Scratch {
+        Scratch() { ++created(); }
+        static std::atomic<int>& created() {
+            static std::atomic<int> count{0};
+            return count;
+        }
+        std::vector<double> buffer;
+    };
+    std::vector<std::size_t> sizes(500);
+    parallelFor<Scratch>(sizes.size(), 4, [&sizes](Scratch& scratch, std::size_t i) {
+        scratch.buffer.assign(i % 7, 1.0);
+        sizes[i] = scratch.buffer.size();
+    });
+    BOOST_CHECK_LE(Scratch::created().load(), 4);
+    for (std::size_t i = 0; i < sizes.size(); ++i) BOOST_CHECK_EQUAL(sizes[i], i % 7);
+}
+
+BOOST_AUTO_TEST_CASE(TestFirstFailureRethrownAfterAllWork) {
+    std::atomic<std::size_t> done{0};
+    BOOST_CHECK_THROW(parallelFor(200, 4, [&done](std::size_t i) {
+        if (i % 50 == 3) throw std::runtime_error("trabajo fallido");
+        ++done;
+    }), std::runtime_error);
+    // Los trabajos que no fallan se completan igualmente
+    BOOST_CHECK_EQUAL(done.load(), 196u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,82 @@
+#define BOOST_TEST_MODULE PortfolioAggregatorTest
+#include <boost/test/unit_test.hpp>
+#include "../portfolio_aggregator.hpp"
+#include "../swap.hpp"
+#include "../instrument_description.hpp"
+#include "../zero_coupon_curve.hpp"
+#include "test_fixtures.hpp"
+#include <random>
+#include <stdexcept>
+
+BOOST_AUTO_TEST_SUITE(PortfolioAggregatorSuite)
+
+static std::vector<double> noisyValues(std::size_t n) {
+    // Magnitudes muy distintas y signos alternos: la suma ingenua pierde precisión
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> mantissa(-1.0, 1.0);
+    std::uniform_int_distribution<int> exponent(-6, 12);
+    std::vector<double> values(n);
+    for (double& value : values) value = mantissa(rng) * std::pow(10.0, exponent(rng));
+    return values;
+}
+
+BOOST_AUTO_TEST_CASE(TestSumIndependentOfThreadCount) {
+    std::vector<double> values = noisyValues(100000);
+
+    double reference = PortfolioAggregator(1).sum(values);
+    for (unsigned threads : {2u, 3u, 8u, 16u}) {
+        BOOST_CHECK_EQUAL(PortfolioAggregator(threads).sum(values), reference);
+    }
+
+    long double exact = 0.0L;
+    for (double value : values) exact += value;
+    BOOST_CHECK_CLOSE(reference, static_cast<double>(exact), 1e-12);
+
+    BOOST_CHECK_EQUAL(PortfolioAggregator(4).sum(std::vector<double>{}), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(TestCompensatedSumRecoversCancellation) {
+    CompensatedSum sum;
+    sum.add(1e16);
+    sum.add(1.0);
+    sum.add(-1e16);
+    BOOST_CHECK_EQUAL(sum.value(), 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(TestBookRiskIndependentOfThreadCount) {
+    auto curve = testCurve();
+
+    std::vector<std::unique_ptr<Swap>> book;
+    for (int i = 0; i < 3000; ++i) {
+        InstrumentDescription desc = swapDescription(0.04 + 0.0001 * (i % 50), 2.0, curve);
+        desc.notional = (i % 2 ? 1e6 : -2.5e5) * (1 + i % 7);
+        book.push_back(std::make_unique<Swap>(desc));
+    }
+
+    auto totals = [&](unsigned threads) {
+        return PortfolioAggregator(threads).sumVectors(book.size(), 2, [&](std::size_t i, double* out) {
+            SwapRisk risk = book[i]->risk(*curve);
+            out[0] = risk.npv;
+            out[1] = risk.dv01;
+        });
+    };
+
+    std::vector<double> reference = totals(1);
+    BOOST_REQUIRE_EQUAL(reference.size(), 2u);
+    for (unsigned threads : {2u, 5u, 8u}) {
+        BOOST_CHECK(totals(threads) == reference);
+    }
+
+    double pv = PortfolioAggregator(4).sum(book.size(), [&](std::size_t i) { return book[i]->npv(*curve); });
+    BOOST_CHECK_EQUAL(pv, reference[0]);
+}
+
+BOOST_AUTO_TEST_CASE(TestPricingErrorPropagates) {
+    PortfolioAggregator aggregator(4);
+    BOOST_CHECK_THROW(aggregator.sum(2000, [](std::size_t i) -> double {
+        if (i == 1500) throw std::runtime_error("fallo de valoración");
+        return 1.0;
+    }), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
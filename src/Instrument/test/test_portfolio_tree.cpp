@@ -0,0 +1,165 @@
+#define BOOST_TEST_MODULE PortfolioTreeTest
+#include <boost/test/unit_test.hpp>
+#include "../portfolio_tree.hpp"
+#include "../bond.hpp"
+#include "../swap.hpp"
+#include "../instrument_description.hpp"
+#include "../zero_coupon_curve.hpp"
+#include "../curve_registry.hpp"
+#include "../factory.hpp"
+#include "../bond_builder.hpp"
+#include "../swap_builder.hpp"
+#include "../factory_registrator.hpp"
+#include "test_fixtures.hpp"
+#include <map>
+
+static FactoryRegistrator<BondBuilder> bondRegistrator;
+static FactoryRegistrator<SwapBuilder> swapRegistrator;
+
+BOOST_AUTO_TEST_SUITE(PortfolioTreeSuite)
+
+// Swap de referencia con el nominal indicado
+static InstrumentDescription notionalSwap(double fixedRate, double notional) {
+    InstrumentDescription desc = swapDescription(fixedRate);
+    desc.notional = notional;
+    return desc;
+}
+
+static double directValue(const InstrumentDescription& desc, const ZeroCouponCurve& curve) {
+    if (desc.type == InstrumentDescription::bond) return Bond(desc).presentValue(curve);
+    return Swap(desc).npv(curve);
+}
+
+BOOST_AUTO_TEST_CASE(TestIncrementalAmendAndCancel) {
+    auto curve = testCurve();
+    PortfolioTree tree("Grupo");
+    PortfolioTree::NodeId entity = tree.addNode(PortfolioTree::kRoot, "Banco SA");
+    PortfolioTree::NodeId rates = tree.addNode(entity, "Tipos");
+    PortfolioTree::NodeId bookA = tree.addNode(rates, "Swaps EUR");
+    PortfolioTree::NodeId bookB = tree.addNode(rates, "Bonos");
+    BOOST_CHECK_EQUAL(tree.addNode(entity, "Tipos"), rates);
+    BOOST_CHECK_EQUAL(tree.depth(bookA), 3u);
+
+    std::map<PortfolioTree::TradeId, InstrumentDescription> book;
+    for (int i = 0; i < 40; ++i) {
+        InstrumentDescription desc = i % 4 == 0 ? bondDescription(0.04 + 0.001 * i)
+                                                : notionalSwap(0.045 + 0.0002 * i, 1e6 * (1 + i % 3));
+        desc.zeroCouponCurve = curve;
+        book.emplace(tree.addTrade(i % 4 == 0 ? bookB : bookA, desc), desc);
+    }
+    BOOST_CHECK_EQUAL(tree.trades(rates), 40u);
+    BOOST_CHECK_EQUAL(tree.trades(bookB), 10u);
+
+    auto fullSum = [&]() {
+        double sum = 0.0;
+        for (const auto& entry : book) sum += directValue(entry.second, *curve);
+        return sum;
+    };
+    BOOST_CHECK_CLOSE(tree.total(PortfolioTree::kRoot).pv, fullSum(), 1e-10);
+
+    // Una modificación solo revalora su trade
+    std::size_t before = tree.repricings();
+    PortfolioTree::TradeId amended = book.begin()->first;
+    InstrumentDescription desc = notionalSwap(0.06, 5e6);
+    desc.zeroCouponCurve = curve;
+    tree.amendTrade(amended, desc);
+    book.at(amended) = desc;
+    BOOST_CHECK_EQUAL(tree.repricings(), before + 1);
+    BOOST_CHECK_CLOSE(tree.tradeValue(amended).pv, directValue(desc, *curve), 1e-12);
+    BOOST_CHECK_CLOSE(tree.total(PortfolioTree::kRoot).pv, fullSum(), 1e-10);
+    BOOST_CHECK_CLOSE(tree.total(entity).pv, tree.total(bookA).pv + tree.total(bookB).pv, 1e-10);
+
+    PortfolioTree::TradeId cancelled = std::next(book.begin())->first;
+    tree.cancelTrade(cancelled);
+    book.erase(cancelled);
+    BOOST_CHECK_EQUAL(tree.trades(PortfolioTree::kRoot), 39u);
+    BOOST_CHECK_CLOSE(tree.total(PortfolioTree::kRoot).pv, fullSum(), 1e-10);
+    BOOST_CHECK_THROW(tree.cancelTrade(cancelled), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(TestCurveUpdateRepricesOnlyDependents) {
+    auto eur = testCurve();
+    auto usd = testCurve(1.0);
+    PortfolioTree tree;
+    PortfolioTree::NodeId eurBook = tree.addNode(PortfolioTree::kRoot, "EUR");
+    PortfolioTree::NodeId usdBook = tree.addNode(PortfolioTree::kRoot, "USD");
+
+    for (int i = 0; i < 30; ++i) {
+        InstrumentDescription desc = notionalSwap(0.05, 1e6);
+        desc.zeroCouponCurve = i < 10 ? eur : usd;
+        tree.addTrade(i < 10 ? eurBook : usdBook, desc);
+    }
+    double usdBefore = tree.total(usdBook).pv;
+
+    std::size_t before = tree.repricings();
+    eur->updateZeroRates({5.0, 5.3, 5.4, 5.5});
+    tree.curveUpdated(*eur);
+    BOOST_CHECK_EQUAL(tree.repricings(), before + 10);
+
+    InstrumentDescription reference = notionalSwap(0.05, 1e6);
+    BOOST_CHECK_CLOSE(tree.total(eurBook).pv, 10 * directValue(reference, *eur), 1e-10);
+    BOOST_CHECK_EQUAL(tree.total(usdBook).pv, usdBefore);
+}
+
+BOOST_AUTO_TEST_CASE(TestRegistryCurves) {
+    auto registry = std::make_shared<CurveRegistry>();
+    registry->publish("EUR-ESTR", testCurve());
+    registry->publish("Euribor6M", testCurve());
+
+    InstrumentDescription desc = notionalSwap(0.05, 1e6);
+    desc.curveRegistry = registry;
+    desc.discountCurve = "EUR-ESTR";
+
+    PortfolioTree tree;
+    PortfolioTree::TradeId id = tree.addTrade(PortfolioTree::kRoot, desc);
+
+    // Con las dos curvas iguales coincide con la valoración monocurva
+    auto single = testCurve();
+    SwapRisk risk = Swap(notionalSwap(0.05, 1e6)).risk(*single);
+    BOOST_CHECK_CLOSE(tree.tradeValue(id).pv, risk.npv, 1e-10);
+    BOOST_CHECK_CLOSE(tree.tradeValue(id).dv01, risk.dv01, 1e-3);
+
+    // Al republicar la curva de proyección se revalora el trade
+    auto shifted = testCurve(0.5);
+    registry->publish("Euribor6M", shifted);
+    tree.curveUpdated(*registry, "Euribor6M");
+    BOOST_CHECK_LT(tree.tradeValue(id).pv, risk.npv);
+    BOOST_CHECK_CLOSE(tree.total(PortfolioTree::kRoot).pv, tree.tradeValue(id).pv, 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(TestAmendKeepsCurveLinks) {
+    auto registry = std::make_shared<CurveRegistry>();
+    registry->publish("EUR-ESTR", testCurve());
+    registry->publish("Euribor6M", testCurve());
+
+    InstrumentDescription desc = notionalSwap(0.05, 1e6);
+    desc.curveRegistry = registry;
+    desc.discountCurve = "EUR-ESTR";
+
+    PortfolioTree tree;
+    PortfolioTree::TradeId id = tree.addTrade(PortfolioTree::kRoot, desc);
+
+    // Modificación con las mismas curvas: sigue dependiendo de ellas
+    desc.fixedRate = 0.045;
+    tree.amendTrade(id, desc);
+    double before = tree.tradeValue(id).pv;
+    registry->publish("Euribor6M", testCurve(0.5));
+    std::size_t repricings = tree.repricings();
+    tree.curveUpdated(*registry, "Euribor6M");
+    BOOST_CHECK_EQUAL(tree.repricings(), repricings + 1);
+    BOOST_CHECK_LT(tree.tradeValue(id).pv, before);
+
+    // Una modificación que falla (índice sin curva publicada) no toca el trade ni sus enlaces
+    InstrumentDescription broken = desc;
+    broken.floatingIndex = "Euribor3M";
+    PortfolioValue value = tree.tradeValue(id);
+    BOOST_CHECK_THROW(tree.amendTrade(id, broken), std::runtime_error);
+    BOOST_CHECK_EQUAL(tree.tradeValue(id).pv, value.pv);
+
+    registry->publish("Euribor6M", testCurve());
+    tree.curveUpdated(*registry, "Euribor6M");
+    BOOST_CHECK_GT(tree.tradeValue(id).pv, value.pv);
+    BOOST_CHECK_CLOSE(tree.total(PortfolioTree::kRoot).pv, tree.tradeValue(id).pv, 1e-12);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,104 @@
+#define BOOST_TEST_MODULE PricingCacheTest
+#include <boost/test/unit_test.hpp>
+#include "../pricing_cache.hpp"
+#include "../bond.hpp"
+#include "../swap.hpp"
+#include "../zero_coupon_curve.hpp"
+#include "../instrument_description.hpp"
+#include "../factory.hpp"
+#include "../bond_builder.hpp"
+#include "../swap_builder.hpp"
+#include "../factory_registrator.hpp"
+#include "test_fixtures.hpp"
+#include <optional>
+
+static FactoryRegistrator<BondBuilder> bondRegistrator;
+static FactoryRegistrator<SwapBuilder> swapRegistrator;
+
+BOOST_AUTO_TEST_SUITE(PricingCacheSuite)
+
+BOOST_AUTO_TEST_CASE(TestCurveVersionIsMonotonic) {
+    ZeroCouponCurve first({5.0, 5.8}, {0.5, 1.0});
+    ZeroCouponCurve second({5.0, 5.8}, {0.5, 1.0});
+    BOOST_CHECK_GT(second.version(), first.version());
+
+    std::uint64_t before = second.version();
+    second.updateZeroRates({5.1, 5.9});
+    BOOST_CHECK_GT(second.version(), before);
+
+    BOOST_CHECK_THROW(second.updateZeroRates({5.1}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(TestMemoizedPriceInvalidatedOnRepublish) {
+    InstrumentDescription bondDescription(InstrumentDescription::bond);
+    bondDescription.maturity = 2.0;
+    bondDescription.couponRate = 0.06;
+    bondDescription.frequency = 2.0;
+    bondDescription.notional = 100;
+    bondDescription.issueDate = boost::gregorian::date(2024, 1, 1);
+    bondDescription.couponDates = {0.5, 1.0, 1.5, 2.0};
+    auto curve = std::make_shared<ZeroCouponCurve>(
+        std::vector<double>{5.0, 5.8, 6.4, 6.8}, std::vector<double>{0.5, 1.0, 1.5, 2.0});
+    bondDescription.zeroCouponCurve = curve;
+
+    auto bond = Factory::instance()(bondDescription);
+    PricingCache cache;
+
+    double first = cache.price(*bond);
+    double second = cache.price(*bond);
+    BOOST_CHECK_EQUAL(first, second);
+    BOOST_CHECK_EQUAL(cache.misses(), 1u);
+    BOOST_CHECK_EQUAL(cache.hits(), 1u);
+
+    // Republicar la curva: el precio memoizado deja de ser válido
+    curve->updateZeroRates({5.5, 6.3, 6.9, 7.3});
+    double repriced = cache.price(*bond);
+    BOOST_CHECK_EQUAL(cache.misses(), 2u);
+    BOOST_CHECK_LT(repriced, first);
+    BOOST_CHECK_CLOSE(repriced, bond->price(), 1e-12);
+
+    cache.invalidate(*bond);
+    BOOST_CHECK_EQUAL(cache.size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(TestSwapSharesCurveVersion) {
+    InstrumentDescription desc = swapDescription(0.05, 2.0, testCurve());
+
+    auto swap = Factory::instance()(desc);
+    PricingCache cache;
+    cache.price(*swap);
+    cache.price(*swap);
+    BOOST_CHECK_EQUAL(cache.hits(), 1u);
+
+    desc.zeroCouponCurve->updateZeroRates({4.80, 5.05, 5.15, 5.25});
+    cache.price(*swap);
+    BOOST_CHECK_EQUAL(cache.misses(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(TestReusedAddressIsNotStale) {
+    auto curve = testCurve();
+    PricingCache cache;
+
+    // Dos bonos distintos construidos en la misma dirección
+    std::optional<Bond> slot;
+    slot.emplace(bondDescription(0.04, curve));
+    const Instrument* address = &*slot;
+    double low = cache.price(*slot);
+
+    slot.reset();
+    slot.emplace(bondDescription(0.08, curve));
+    BOOST_REQUIRE_EQUAL(static_cast<const Instrument*>(&*slot), address);
+
+    double high = cache.price(*slot);
+    BOOST_CHECK_EQUAL(cache.misses(), 2u);
+    BOOST_CHECK_GT(high, low);
+    BOOST_CHECK_CLOSE(high, slot->price(), 1e-12);
+
+    // Una copia valora el mismo trade y comparte la entrada
+    Bond copy(*slot);
+    BOOST_CHECK_EQUAL(copy.instrumentId(), slot->instrumentId());
+    cache.price(copy);
+    BOOST_CHECK_EQUAL(cache.hits(), 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,179 @@
+#define BOOST_TEST_MODULE PricingServerTest
+#include <boost/test/unit_test.hpp>
+#include "../pricing_server.hpp"
+#include "../bond.hpp"
+#include "../swap.hpp"
+#include "../instrument_description.hpp"
+#include "../zero_coupon_curve.hpp"
+#include "test_fixtures.hpp"
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <dirent.h>
+#include <unistd.h>
+
+BOOST_AUTO_TEST_SUITE(PricingServerSuite)
+
+static std::unique_ptr<Instrument> makeTrade(int i, std::shared_ptr<ZeroCouponCurve> curve) {
+    if (i % 3 == 0) {
+        InstrumentDescription desc(InstrumentDescription::bond);
+        desc.maturity = 2.0;
+        desc.couponRate = 0.04 + 0.001 * (i % 20);
+        desc.frequency = 2.0;
+        desc.notional = 100;
+        desc.issueDate = boost::gregorian::date(2016, 4, 1);
+        desc.couponDates = {0.5, 1.0, 1.5, 2.0};
+        desc.zeroCouponCurve = curve;
+        return std::make_unique<Bond>(desc);
+    }
+    InstrumentDescription desc(InstrumentDescription::swap);
+    desc.notional = 1000000;
+    desc.fixedRate = 0.045 + 0.0005 * (i % 20);
+    desc.fixedFrequency = 2.0;
+    desc.floatingFrequency = 2.0;
+    desc.initialFixing = 0.048;
+    desc.floatingIndex = "Euribor6M";
+    desc.dayCountConvention = "ACT/360";
+    desc.issueDate = boost::gregorian::date(2016, 4, 1);
+    desc.maturity = 2.0;
+    desc.zeroCouponCurve = curve;
+    return std::make_unique<Swap>(desc);
+}
+
+static std::string socketPath(const char* name) {
+    return "/tmp/" + std::string(name) + "_" + std::to_string(::getpid()) + ".sock";
+}
+
+static std::size_t openDescriptors() {
+    std::size_t count = 0;
+    DIR* dir = ::opendir("/proc/self/fd");
+    while (dir && ::readdir(dir)) ++count;
+    if (dir) ::closedir(dir);
+    return count;
+}
+
+// Valor y dv01 esperados, calculados directamente en el proceso
+static protocol::TradeResult expected(const Instrument& instrument, const ZeroCouponCurve& curve) {
+    if (const Bond* bond = dynamic_cast<const Bond*>(&instrument)) {
+        BondRisk risk = bond->risk(curve);
+        return {risk.price, risk.dv01};
+    }
+    SwapRisk risk = static_cast<const Swap&>(instrument).risk(curve);
+    return {risk.npv, risk.dv01};
+}
+
+BOOST_AUTO_TEST_CASE(TestPriceRiskAndRepublish) {
+    auto curve = testCurve();
+    auto handle = std::make_shared<CurveHandle>(curve);
+    PricingServer server(socketPath("pricing_server_basic"), handle);
+
+    std::vector<std::unique_ptr<Instrument>> reference;
+    for (int i = 0; i < 6; ++i) {
+        reference.push_back(makeTrade(i, curve));
+        server.add(makeTrade(i, curve));
+    }
+    server.start();
+
+    PricingClient client(server.socketPath());
+    std::vector<std::uint32_t> ids = {5, 0, 3, 0};
+    auto prices = client.price(ids);
+    auto risks = client.risk(ids);
+    BOOST_REQUIRE_EQUAL(prices.size(), ids.size());
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        protocol::TradeResult direct = expected(*reference[ids[i]], *curve);
+        BOOST_CHECK_CLOSE(prices[i].value, direct.value, 1e-12);
+        BOOST_CHECK_EQUAL(prices[i].dv01, 0.0);
+        BOOST_CHECK_CLOSE(risks[i].dv01, direct.dv01, 1e-12);
+    }
+
+    // Una curva republicada se usa en el siguiente lote
+    auto shifted = testCurve(0.5);
+    handle->publish(shifted);
+    auto repriced = client.price({0});
+    BOOST_CHECK_CLOSE(repriced[0].value, expected(*reference[0], *shifted).value, 1e-12);
+
+    BOOST_CHECK_THROW(client.price({99}), std::runtime_error);
+    // La conexión sigue siendo válida después de un rechazo
+    BOOST_CHECK_EQUAL(client.price({1}).size(), 1u);
+
+    server.stop();
+    BOOST_CHECK_GE(server.requests(), 5u);
+}
+
+BOOST_AUTO_TEST_CASE(TestFailedStartClosesDescriptors) {
+    PricingServer server("/tmp/pricing_server_missing_dir/server.sock", std::make_shared<CurveHandle>(testCurve()));
+    server.add(makeTrade(0, testCurve()));
+
+    std::size_t before = openDescriptors();
+    BOOST_CHECK_THROW(server.start(), std::runtime_error);
+    BOOST_CHECK_THROW(server.start(), std::runtime_error);
+    BOOST_CHECK_EQUAL(openDescriptors(), before);
+    server.stop();   // Sin arrancar: no hace nada
+}
+
+// Generador de carga: varios clientes concurrentes contra un mismo servidor
+BOOST_AUTO_TEST_CASE(TestConcurrentLoad) {
+    auto curve = testCurve();
+    auto handle = std::make_shared<CurveHandle>(curve);
+    PricingServer server(socketPath("pricing_server_load"), handle);
+
+    const int trades = 300;
+    std::vector<std::unique_ptr<Instrument>> reference;
+    for (int i = 0; i < trades; ++i) {
+        reference.push_back(makeTrade(i, curve));
+        server.add(makeTrade(i, curve));
+    }
+    std::vector<protocol::TradeResult> direct;
+    for (const auto& trade : reference) direct.push_back(expected(*trade, *curve));
+    server.start();
+
+    const int clients = 8;
+    const int requestsPerClient = 500;
+    const int tradesPerRequest = 16;
+    std::vector<std::vector<double>> latencies(clients);
+    std::vector<int> mismatches(clients, 0);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int c = 0; c < clients; ++c) {
+        threads.emplace_back([&, c]() {
+            PricingClient client(server.socketPath());
+            std::mt19937 rng(c);
+            std::uniform_int_distribution<std::uint32_t> pick(0, trades - 1);
+            std::vector<std::uint32_t> ids(tradesPerRequest);
+            std::vector<protocol::TradeResult> results;
+            for (int r = 0; r < requestsPerClient; ++r) {
+                for (auto& id : ids) id = pick(rng);
+                auto sent = std::chrono::steady_clock::now();
+                client.request(protocol::Operation::Risk, ids, results);
+                auto received = std::chrono::steady_clock::now();
+                latencies[c].push_back(std::chrono::duration<double, std::micro>(received - sent).count());
+                for (int i = 0; i < tradesPerRequest; ++i) {
+                    if (results[i].value != direct[ids[i]].value) ++mismatches[c];
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    server.stop();
+
+    std::vector<double> all;
+    for (int c = 0; c < clients; ++c) {
+        BOOST_CHECK_EQUAL(mismatches[c], 0);
+        all.insert(all.end(), latencies[c].begin(), latencies[c].end());
+    }
+    std::sort(all.begin(), all.end());
+    double p50 = all[all.size() / 2];
+    double p99 = all[static_cast<std::size_t>(all.size() * 0.99)];
+
+    BOOST_CHECK_EQUAL(server.requests(), static_cast<std::size_t>(clients * requestsPerClient));
+    BOOST_CHECK_LE(server.batches(), server.requests());
+    BOOST_TEST_MESSAGE("Peticiones/s: " << all.size() / seconds
+                       << " | p50: " << p50 << " us | p99: " << p99 << " us"
+                       << " | peticiones por lote: "
+                       << static_cast<double>(server.requests()) / server.batches());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
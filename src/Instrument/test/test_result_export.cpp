@@ -0,0 +1,242 @@
+#define BOOST_TEST_MODULE ResultExportTest
+#include <boost/test/unit_test.hpp>
+#include "../result_export.hpp"
+#include "../instrument_variant.hpp"
+#include "test_fixtures.hpp"
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <utility>
+#include <chrono>
+
+static InstrumentBook mixedBook(size_t n) {
+    InstrumentBook book;
+    for (size_t i = 0; i < n; ++i) {
+        double rate = 0.04 + 0.0001 * static_cast<double>(i % 50);
+        book.add(i % 3 == 0 ? swapDescription(rate, 2.0, testCurve(-0.1)) : bondDescription(rate, testCurve(0.2)));
+    }
+    return book;
+}
+
+static std::vector<std::string> readLines(const std::string& path) {
+    std::ifstream input(path);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(input, line);) lines.push_back(line);
+    return lines;
+}
+
+BOOST_AUTO_TEST_SUITE(ResultExportSuite)
+
+BOOST_AUTO_TEST_CASE(TestCashflowTableRoundTrip) {
+    const std::string path = "test_cashflows.zcrt";
+    InstrumentBook book = mixedBook(40);
+    auto curve = testCurve();
+
+    // Bloques pequeños para que los trades crucen fronteras de bloque
+    CashflowBuffer all, buffer;
+    std::vector<double> expectedPv(book.size());
+    std::vector<std::uint64_t> expectedTrade;
+    {
+        CashflowExporter exporter(path, ExportFormat::Columnar, 7);
+        book.forEach([&](const auto& instrument, size_t position) {
+            buffer.clear();
+            instrument.cashflows(*curve, buffer);
+            exporter.add(position, *curve, buffer);
+            expectedPv[position] = discountCashflows(*curve, buffer);
+            for (size_t i = 0; i < buffer.size(); ++i) {
+                all.add(buffer.time(i), buffer.amount(i), buffer.info(i));
+                expectedTrade.push_back(position);
+            }
+        });
+        BOOST_CHECK_EQUAL(exporter.rows(), all.size());
+        exporter.close();
+    }
+
+    ColumnarReader reader(path);
+    BOOST_REQUIRE_EQUAL(reader.rows(), all.size());
+    BOOST_CHECK_EQUAL(reader.chunks(), (all.size() + 6) / 7);
+    BOOST_CHECK_EQUAL(reader.schema().size(), CashflowExporter::schema().size());
+    BOOST_CHECK_EQUAL(reader.columnIndex("discount_factor"), static_cast<size_t>(CashflowExporter::DiscountFactor));
+
+    auto trades = reader.column<std::uint64_t>(CashflowExporter::TradeId);
+    auto legs = reader.column<std::uint8_t>(CashflowExporter::Leg);
+    auto times = reader.column<double>(CashflowExporter::Time);
+    auto amounts = reader.column<double>(CashflowExporter::Amount);
+    auto dfs = reader.column<double>(CashflowExporter::DiscountFactor);
+    auto pvs = reader.column<double>(CashflowExporter::PresentValue);
+    auto rates = reader.column<double>(CashflowExporter::Rate);
+    auto projected = reader.column<std::uint8_t>(CashflowExporter::Projected);
+
+    BOOST_CHECK(trades == expectedTrade);
+    std::vector<double> pvByTrade(book.size(), 0.0);
+    for (size_t i = 0; i < all.size(); ++i) {
+        BOOST_CHECK_EQUAL(legs[i], static_cast<std::uint8_t>(all.info(i).leg));
+        BOOST_CHECK_EQUAL(times[i], all.time(i));
+        BOOST_CHECK_EQUAL(amounts[i], all.amount(i));
+        BOOST_CHECK_EQUAL(dfs[i], curve->getDiscountFactor(all.time(i)));
+        BOOST_CHECK_EQUAL(rates[i], all.info(i).rate);
+        BOOST_CHECK_EQUAL(projected[i] != 0, all.info(i).projected);
+        pvByTrade[trades[i]] += pvs[i];
+    }
+    // La suma de la columna de PV reproduce la valoración de cada trade
+    for (size_t t = 0; t < book.size(); ++t) BOOST_CHECK_CLOSE(pvByTrade[t], expectedPv[t], 1e-12);
+
+    BOOST_CHECK_THROW(reader.column<double>(CashflowExporter::Leg), std::invalid_argument);
+    BOOST_CHECK_THROW(reader.columnIndex("missing"), std::invalid_argument);
+    std::remove(path.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(TestTradeResultsCsvAndBinaryAgree) {
+    const std::string csvPath = "test_trades.csv", binaryPath = "test_trades.zcrt";
+    InstrumentBook book = mixedBook(25);
+    std::vector<double> pvs, bumped;
+    book.price(*testCurve(), pvs);
+    book.price(*testCurve(-0.01), bumped);
+    {
+        TradeResultExporter csv(csvPath, ExportFormat::Csv, 10);
+        TradeResultExporter binary(binaryPath, ExportFormat::Columnar, 10);
+        for (size_t i = 0; i < pvs.size(); ++i) {
+            csv.add(i, pvs[i], bumped[i] - pvs[i]);
+            binary.add(i, pvs[i], bumped[i] - pvs[i]);
+        }
+        // Sin close(): el destructor entrega el último bloque
+    }
+
+    std::vector<std::string> lines = readLines(csvPath);
+    BOOST_REQUIRE_EQUAL(lines.size(), pvs.size() + 1);
+    BOOST_CHECK_EQUAL(lines.front(), "trade_id,present_value,dv01");
+
+    ColumnarReader reader(binaryPath);
+    BOOST_REQUIRE_EQUAL(reader.rows(), pvs.size());
+    auto binaryPv = reader.column<double>(TradeResultExporter::PresentValue);
+    for (size_t i = 0; i < pvs.size(); ++i) {
+        // El texto se relee al mismo double que el binario
+        std::istringstream fields(lines[i + 1]);
+        std::string id, pv, dv01;
+        std::getline(fields, id, ',');
+        std::getline(fields, pv, ',');
+        std::getline(fields, dv01, ',');
+        BOOST_CHECK_EQUAL(std::stoull(id), i);
+        BOOST_CHECK_EQUAL(std::strtod(pv.c_str(), nullptr), pvs[i]);
+        BOOST_CHECK_EQUAL(std::strtod(dv01.c_str(), nullptr), bumped[i] - pvs[i]);
+        BOOST_CHECK_EQUAL(binaryPv[i], pvs[i]);
+    }
+    std::remove(csvPath.c_str());
+    std::remove(binaryPath.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(TestErrors) {
+    BOOST_CHECK_THROW(CashflowExporter("missing_directory/flows.zcrt"), std::runtime_error);
+    BOOST_CHECK_THROW(ColumnarReader("does_not_exist.zcrt"), std::runtime_error);
+
+    // Un CSV no es un fichero columnar
+    const std::string path = "test_not_columnar.csv";
+    {
+        TradeResultExporter csv(path, ExportFormat::Csv);
+        for (int i = 0; i < 10; ++i) csv.add(i, 1.0, 0.0);
+    }
+    BOOST_CHECK_THROW(ColumnarReader reader(path), std::runtime_error);
+    std::remove(path.c_str());
+
+    // Fichero sin filas
+    const std::string empty = "test_empty.zcrt";
+    TradeResultExporter(empty).close();
+    ColumnarReader reader(empty);
+    BOOST_CHECK_EQUAL(reader.rows(), 0u);
+    BOOST_CHECK_EQUAL(reader.chunks(), 0u);
+    std::remove(empty.c_str());
+
+    // Pie y bloques corruptos se rechazan antes de reservar memoria con sus tamaños
+    const std::string corrupt = "test_corrupt.zcrt";
+    {
+        TradeResultExporter exporter(corrupt, ExportFormat::Columnar, 4);
+        for (int i = 0; i < 10; ++i) exporter.add(i, 1.0, 0.0);
+    }
+    std::string original;
+    {
+        std::ifstream input(corrupt, std::ios::binary);
+        original.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    }
+    auto readWord = [&original](size_t position) {
+        std::uint64_t value;
+        std::memcpy(&value, original.data() + position, sizeof(value));
+        return value;
+    };
+    auto rewrite = [&](std::vector<std::pair<size_t, std::uint64_t>> patches) {
+        std::string bytes = original;
+        for (const auto& patch : patches) std::memcpy(&bytes[patch.first], &patch.second, sizeof(patch.second));
+        std::ofstream(corrupt, std::ios::binary | std::ios::trunc) << bytes;
+    };
+    const size_t footerRows = original.size() - 24;            // Pie: bloques, filas, offset del índice, magic
+    const size_t firstChunk = readWord(readWord(original.size() - 16));
+    BOOST_REQUIRE_EQUAL(readWord(footerRows), 10u);
+
+    rewrite({{footerRows, 11}});                                // Más filas que la suma de los bloques
+    BOOST_CHECK_THROW(ColumnarReader reader(corrupt), std::runtime_error);
+    rewrite({{footerRows, ~std::uint64_t(0)}});
+    BOOST_CHECK_THROW(ColumnarReader reader(corrupt), std::runtime_error);
+    rewrite({{firstChunk, 3}});                                 // Bloque con menos filas que el pie
+    BOOST_CHECK_THROW(ColumnarReader reader(corrupt), std::runtime_error);
+    rewrite({{firstChunk, std::uint64_t(1) << 61}, {footerRows, (std::uint64_t(1) << 61) + 6}});
+    BOOST_CHECK_THROW(ColumnarReader reader(corrupt), std::runtime_error);   // rows * width desborda
+
+    rewrite({});
+    ColumnarReader restored(corrupt);
+    BOOST_CHECK_EQUAL(restored.rows(), 10u);
+    BOOST_CHECK_EQUAL(restored.chunks(), 3u);
+    std::remove(corrupt.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(TestLargeExportTiming) {
+    const std::string path = "test_large_cashflows.zcrt";
+    InstrumentBook book = mixedBook(30);
+    auto curve = testCurve();
+    CashflowBuffer buffer;
+    std::vector<size_t> bounds{0};
+    book.forEach([&](const auto& instrument, size_t) {
+        instrument.cashflows(*curve, buffer);
+        bounds.push_back(buffer.size());
+    });
+
+    // Mismo bucle de descuento con y sin exportación
+    const size_t rounds = 4000;
+    double sink = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; ++r)
+        for (size_t t = 0; t + 1 < bounds.size(); ++t) sink += discountCashflows(*curve, buffer, bounds[t], bounds[t + 1]);
+    auto middle = std::chrono::steady_clock::now();
+    std::uint64_t rows;
+    {
+        CashflowExporter exporter(path);
+        for (size_t r = 0; r < rounds; ++r)
+            for (size_t t = 0; t + 1 < bounds.size(); ++t) exporter.add(r * book.size() + t, *curve, buffer, bounds[t], bounds[t + 1]);
+        rows = exporter.rows();
+        exporter.close();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    auto loadStart = std::chrono::steady_clock::now();
+    ColumnarReader reader(path);
+    double total = 0.0;
+    for (size_t k = 0; k < reader.chunks(); ++k) {
+        const double* pv = reader.chunkColumn<double>(k, CashflowExporter::PresentValue);
+        for (size_t i = 0; i < reader.chunkRows(k); ++i) total += pv[i];
+    }
+    auto loadEnd = std::chrono::steady_clock::now();
+
+    BOOST_CHECK_EQUAL(reader.rows(), rows);
+    BOOST_CHECK_CLOSE(total, sink, 1e-9);
+
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    double pricingMs = Milliseconds(middle - start).count();
+    double exportMs = Milliseconds(end - middle).count();
+    double loadMs = Milliseconds(loadEnd - loadStart).count();
+    BOOST_TEST_MESSAGE(rows << " flujos: descuento " << pricingMs << " ms, descuento y exportación "
+                       << exportMs << " ms, lectura de la columna de PV " << loadMs << " ms ("
+                       << reader.fileSize() / (1024 * 1024) << " MB)");
+    std::remove(path.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,101 @@
+#define BOOST_TEST_MODULE RiskTest
+#include <boost/test/unit_test.hpp>
+#include "../bond.hpp"
+#include "../swap.hpp"
+#include "../instrument_description.hpp"
+#include "../zero_coupon_curve.hpp"
+#include "../discount_curve.hpp"
+#include "test_fixtures.hpp"
+
+// El riesgo analítico es frente a un spread continuo en el tiempo de cada
+// flujo: DF(t) -> DF(t) e^{-s t}. Se compara con valores cerrados que no pasan
+// por SpreadCurve: momentos de los flujos descontados y curvas planas (r ± s)
+static const double kBump = 1e-4;
+
+// P = Σ CF DF, dP/ds = -Σ t CF DF y d²P/ds² = Σ t² CF DF sobre los flujos del bono
+static void checkBondRisk(const Bond& bond, const ZeroCouponCurve& curve) {
+    double price = 0.0, first = 0.0, second = 0.0;
+    const std::vector<double>& times = bond.getCashflowTimes();
+    for (size_t i = 0; i < times.size(); ++i) {
+        double pv = bond.getCashflowAmounts()[i] * curve.getDiscountFactor(times[i]);
+        price += pv;
+        first += times[i] * pv;
+        second += times[i] * times[i] * pv;
+    }
+
+    BondRisk risk = bond.risk(curve);
+    BOOST_CHECK_CLOSE(risk.price, price, 1e-10);
+    BOOST_CHECK_CLOSE(risk.dv01, first * kBump, 1e-10);
+    BOOST_CHECK_CLOSE(risk.modifiedDuration, first / price, 1e-10);
+    BOOST_CHECK_CLOSE(risk.convexity, second / price, 1e-10);
+}
+
+BOOST_AUTO_TEST_SUITE(RiskSuite)
+
+BOOST_AUTO_TEST_CASE(TestBondRiskMatchesClosedForm) {
+    std::vector<double> rates = {5.0, 5.8, 6.4, 6.8};
+    std::vector<double> maturities = {0.5, 1.0, 1.5, 2.0};
+
+    InstrumentDescription desc(InstrumentDescription::bond);
+    desc.maturity = 2.0;
+    desc.couponRate = 0.06;
+    desc.frequency = 2.0;
+    desc.notional = 100;
+    desc.issueDate = boost::gregorian::date(2024, 1, 1);
+    desc.couponDates = {0.5, 1.0, 1.5, 2.0};
+    desc.zeroCouponCurve = std::make_shared<ZeroCouponCurve>(rates, maturities);
+    Bond bond(desc);
+
+    BondRisk risk = bond.risk(*desc.zeroCouponCurve);
+    BOOST_CHECK_CLOSE(risk.price, bond.price(), 1e-10);
+    checkBondRisk(bond, *desc.zeroCouponCurve);
+    BOOST_CHECK_GT(risk.macaulayDuration, 1.9);
+    BOOST_CHECK_LT(risk.macaulayDuration, 2.0);
+
+    // Flujos entre pilares y vencimiento después del último pilar
+    desc.couponDates = {0.3, 0.8, 1.3, 1.8, 2.3};
+    desc.maturity = 2.6;
+    Bond offPillar(desc);
+    offPillar.setVerbose(false);
+    BOOST_CHECK_GT(offPillar.getCashflowTimes().back(), maturities.back());
+    checkBondRisk(offPillar, *desc.zeroCouponCurve);
+
+    // Sobre una curva plana el desplazamiento es otra curva plana: r ± 1pb
+    const double rate = 0.06;
+    BondRisk flat = offPillar.risk(FlatCurve(rate));
+    double up = offPillar.risk(FlatCurve(rate + kBump)).price;
+    double down = offPillar.risk(FlatCurve(rate - kBump)).price;
+    BOOST_CHECK_CLOSE(flat.dv01, (down - up) / 2.0, 1e-4);
+    BOOST_CHECK_CLOSE(flat.modifiedDuration, (down - up) / (2.0 * kBump * flat.price), 1e-4);
+    BOOST_CHECK_CLOSE(flat.convexity, (up + down - 2.0 * flat.price) / (kBump * kBump * flat.price), 0.01);
+}
+
+BOOST_AUTO_TEST_CASE(TestSwapRiskMatchesFiniteDifferences) {
+    InstrumentDescription desc = swapDescription(0.05, 2.0, testCurve());
+    Swap swap(desc);
+
+    SwapRisk risk = swap.risk(*desc.zeroCouponCurve);
+    SwapValuation valuation = swap.valuation(*desc.zeroCouponCurve);
+    BOOST_CHECK_CLOSE(risk.npv, valuation.npv, 1e-10);
+    BOOST_CHECK_CLOSE(risk.parRate, valuation.parRate, 1e-10);
+
+    // Sobre una curva plana el desplazamiento es otra curva plana: r ± 1pb
+    const double rate = 0.05;
+    const double h = kBump;
+    for (double maturity : {2.0, 2.5}) {
+        InstrumentDescription flatDesc = desc;
+        flatDesc.maturity = maturity;
+        Swap flatSwap(flatDesc);
+        double up = flatSwap.npv(FlatCurve(rate + h));
+        double down = flatSwap.npv(FlatCurve(rate - h));
+        BOOST_CHECK_CLOSE(flatSwap.risk(FlatCurve(rate)).dv01, (down - up) / 2.0, 1e-3);
+    }
+
+    // PV01: cambio del NPV al subir 1pb la tasa fija
+    InstrumentDescription bumpedFixed = desc;
+    bumpedFixed.fixedRate += h;
+    double pv01 = Swap(bumpedFixed).npv(*desc.zeroCouponCurve) - risk.npv;
+    BOOST_CHECK_CLOSE(risk.pv01, pv01, 1e-6);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
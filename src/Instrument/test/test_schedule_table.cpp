@@ -0,0 +1,50 @@
+#define BOOST_TEST_MODULE ScheduleTableTest
+#include <boost/test/unit_test.hpp>
+#include "../schedule_table.hpp"
+#include <vector>
+
+using boost::gregorian::date;
+
+static std::vector<date> collect(const date& start, int frequency, int periods) {
+    std::vector<date> dates;
+    schedule::forEachPaymentDate(start, frequency, periods,
+                                 [&dates](int, const date& d) { dates.push_back(d); });
+    return dates;
+}
+
+BOOST_AUTO_TEST_SUITE(ScheduleTableSuite)
+
+BOOST_AUTO_TEST_CASE(TestCompileTimePatterns) {
+    static_assert(schedule::PeriodPattern<2>::monthsPerPeriod == 6, "");
+    static_assert(schedule::PeriodPattern<4>::monthOffsets[3] == 9, "");
+    static_assert(schedule::StandardSchedule<2, 24>::periods == 4, "");
+    static_assert(schedule::StandardSchedule<1, 18>::periods == 2, "");
+    static_assert(schedule::periodsForTenor(12, 120) == 120, "");
+    BOOST_CHECK(schedule::isStandardFrequency(4));
+    BOOST_CHECK(!schedule::isStandardFrequency(3));
+}
+
+BOOST_AUTO_TEST_CASE(TestAnchoredDates) {
+    date start(2016, 4, 1);
+
+    // Plazo estándar (desenrollado) y no estándar (tabla) dan el mismo patrón
+    std::vector<date> standard = collect(start, 2, 4);
+    std::vector<date> irregular = collect(start, 2, 5);
+    BOOST_REQUIRE_EQUAL(standard.size(), 4u);
+    BOOST_REQUIRE_EQUAL(irregular.size(), 5u);
+    for (size_t k = 0; k < standard.size(); ++k) {
+        BOOST_CHECK_EQUAL(standard[k], start + boost::gregorian::months(6 * (k + 1)));
+        BOOST_CHECK_EQUAL(irregular[k], standard[k]);
+    }
+
+    // Frecuencia no estándar: cálculo en tiempo de ejecución
+    std::vector<date> bimonthly = collect(start, 6, 3);
+    BOOST_CHECK_EQUAL(bimonthly.back(), date(2016, 10, 1));
+
+    // Anclar a la fecha de inicio evita la deriva de fin de mes
+    std::vector<date> monthEnd = collect(date(2016, 8, 30), 2, 2);
+    BOOST_CHECK_EQUAL(monthEnd[0], date(2017, 2, 28));
+    BOOST_CHECK_EQUAL(monthEnd[1], date(2017, 8, 30));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
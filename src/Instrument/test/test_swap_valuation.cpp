@@ -0,0 +1,69 @@
+#define BOOST_TEST_MODULE SwapValuationTest
+#include <boost/test/unit_test.hpp>
+#include "../swap.hpp"
+#include "../instrument_description.hpp"
+#include "../zero_coupon_curve.hpp"
+#include "test_fixtures.hpp"
+#include <cmath>
+
+BOOST_AUTO_TEST_SUITE(SwapValuationSuite)
+
+BOOST_AUTO_TEST_CASE(TestClosedFormMatchesPeriodByPeriod) {
+    InstrumentDescription desc = swapDescription(0.05, 2.0, testCurve());
+    Swap swap(desc);
+    const ZeroCouponCurve& curve = *desc.zeroCouponCurve;
+
+    SwapValuation v = swap.valuation(curve);
+
+    // Recorrido explícito con forwards simples L_i = (DF_{i-1}/DF_i - 1) / τ_i
+    std::vector<double> times = {183.0 / 360, 365.0 / 360, 548.0 / 360, 730.0 / 360};
+    double annuity = 0.0, floating = 0.0, previousTime = 0.0;
+    for (size_t i = 0; i < times.size(); ++i) {
+        double accrual = times[i] - previousTime;
+        double df = curve.getDiscountFactor(times[i]);
+        double rate = (i == 0) ? 0.048
+                               : (curve.getDiscountFactor(previousTime) / df - 1.0) / accrual;
+        annuity += accrual * df;
+        floating += rate * accrual * df;
+        previousTime = times[i];
+    }
+
+    BOOST_CHECK_CLOSE(v.annuity, annuity, 1e-10);
+    BOOST_CHECK_CLOSE(v.parRate, floating / annuity, 1e-10);
+    BOOST_CHECK_CLOSE(v.npv, 100 * (0.05 * annuity - floating), 1e-8);
+    BOOST_CHECK_CLOSE(swap.annuity(curve), v.annuity, 1e-12);
+
+    // Frente a price() solo cambia la convención de capitalización del forward
+    BOOST_CHECK_SMALL(v.npv - swap.price(), 0.05);
+}
+
+BOOST_AUTO_TEST_CASE(TestParRateZeroesNpv) {
+    InstrumentDescription desc = swapDescription(0.05, 2.0, testCurve());
+    Swap swap(desc);
+    double parRate = swap.parRate(*desc.zeroCouponCurve);
+
+    Swap atPar(swapDescription(parRate, 2.0, testCurve()));
+    BOOST_CHECK_SMALL(atPar.npv(*desc.zeroCouponCurve), 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE(TestBatchValuation) {
+    std::vector<std::unique_ptr<Swap>> book;
+    std::vector<const Swap*> swaps;
+    for (int i = 0; i < 10; ++i) {
+        book.push_back(std::make_unique<Swap>(swapDescription(0.04 + 0.002 * i, 2.0, testCurve())));
+        swaps.push_back(book.back().get());
+    }
+
+    auto curve = testCurve();
+    std::vector<SwapValuation> results;
+    Swap::valuations(swaps, *curve, results);
+
+    BOOST_REQUIRE_EQUAL(results.size(), swaps.size());
+    for (size_t i = 0; i < swaps.size(); ++i) {
+        BOOST_CHECK_EQUAL(results[i].npv, swaps[i]->npv(*curve));
+    }
+    // NPV creciente con la tasa fija (recibimos fijo)
+    BOOST_CHECK_LT(results.front().npv, results.back().npv);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
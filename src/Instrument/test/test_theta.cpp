@@ -0,0 +1,100 @@
+#define BOOST_TEST_MODULE ThetaTest
+#include <boost/test/unit_test.hpp>
+#include "../theta_engine.hpp"
+#include "../bond.hpp"
+#include "../swap.hpp"
+#include "../instrument_description.hpp"
+#include "../zero_coupon_curve.hpp"
+#include "test_fixtures.hpp"
+#include <cmath>
+
+BOOST_AUTO_TEST_SUITE(ThetaSuite)
+
+static std::shared_ptr<ZeroCouponCurve> bondCurve() {
+    return std::make_shared<ZeroCouponCurve>(
+        std::vector<double>{5.0, 5.8, 6.4, 6.8}, std::vector<double>{0.5, 1.0, 1.5, 2.0});
+}
+
+BOOST_AUTO_TEST_CASE(TestZeroHorizonMatchesToday) {
+    auto curve = bondCurve();
+    Bond bond(bondDescription(0.06, curve));
+    HorizonValue bondValue = bond.valueAt(*curve, 0.0);
+    BOOST_CHECK_CLOSE(bondValue.pv, bond.presentValue(*curve), 1e-12);
+    BOOST_CHECK_EQUAL(bondValue.paid, 0.0);
+
+    auto sc = testCurve();
+    Swap swap(swapDescription(0.05, 2.0, sc));
+    HorizonValue swapValue = swap.valueAt(*sc, *sc, 0.0);
+    BOOST_CHECK_CLOSE(swapValue.pv, swap.npv(*sc), 1e-10);
+    BOOST_CHECK_EQUAL(swapValue.paid, 0.0);
+
+    ThetaEngine engine(curve, ThetaEngine::RollMode::ForwardImplied);
+    engine.add(bond);
+    BOOST_CHECK_SMALL(engine.bookTheta(0), 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(TestRolledCurveRealisesForwards) {
+    auto curve = bondCurve();
+    auto rolled = curve->rolledForward(180);
+
+    BOOST_CHECK(rolled->version() != curve->version());
+    BOOST_CHECK(rolled->getIssueDate() == curve->getIssueDate() + boost::gregorian::days(180));
+    for (double t : {0.5, 1.0, 1.5}) {
+        BOOST_CHECK_CLOSE(rolled->getDiscountFactor(t),
+                          curve->getDiscountFactor(t + 0.5) / curve->getDiscountFactor(0.5), 1e-10);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestBondThetaDropsPaidCoupon) {
+    auto curve = bondCurve();
+    Bond bond(bondDescription(0.06, curve));
+
+    ThetaEngine engine(curve, ThetaEngine::RollMode::ForwardImplied);
+    engine.add(bond);
+    std::vector<ThetaResult> results = engine.theta(180);
+    BOOST_REQUIRE_EQUAL(results.size(), 1u);
+
+    // El cupón de 0.5 ya se ha cobrado; el resto crece al forward de hoy
+    double df05 = curve->getDiscountFactor(0.5);
+    double expected = (3.0 * curve->getDiscountFactor(1.0) + 3.0 * curve->getDiscountFactor(1.5)
+                       + 103.0 * curve->getDiscountFactor(2.0)) / df05;
+    BOOST_CHECK_CLOSE(results[0].paid, 3.0, 1e-12);
+    BOOST_CHECK_CLOSE(results[0].rolledPv, expected, 1e-10);
+    BOOST_CHECK_CLOSE(results[0].theta, expected + 3.0 - bond.presentValue(*curve), 1e-10);
+    BOOST_CHECK_GT(results[0].theta, 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(TestSwapThetaAcrossFirstPayment) {
+    auto curve = testCurve();
+    Swap swap(swapDescription(0.05, 2.0, curve));
+    const double h = 200.0 / 360;
+
+    HorizonValue value = swap.valueAt(*curve, *curve, h);
+
+    // Primer periodo liquidado: cupón fijo contra el fixing inicial
+    double tau1 = 183.0 / 360;
+    BOOST_CHECK_CLOSE(value.paid, 100 * (0.05 - 0.048) * tau1, 1e-10);
+
+    // Periodo en curso fijado con el forward de hoy, el resto telescopa en la curva desplazada
+    std::vector<double> times = {365.0 / 360, 548.0 / 360, 730.0 / 360};
+    double annuity = 0.0, previousTime = tau1;
+    for (double t : times) {
+        annuity += (t - previousTime) * curve->getDiscountFactor(t - h);
+        previousTime = t;
+    }
+    double fixing = curve->getDiscountFactor(tau1) / curve->getDiscountFactor(times[0]);
+    double floating = fixing * curve->getDiscountFactor(times[0] - h)
+                    - curve->getDiscountFactor(times.back() - h);
+    BOOST_CHECK_CLOSE(value.pv, 100 * (0.05 * annuity - floating), 1e-10);
+
+    // Tras el vencimiento todo está liquidado
+    HorizonValue expired = swap.valueAt(*curve, *curve, 3.0);
+    BOOST_CHECK_EQUAL(expired.pv, 0.0);
+
+    ThetaEngine engine(curve);
+    engine.add(swap);
+    BOOST_CHECK_CLOSE(engine.bookTheta(200), value.pv + value.paid - swap.npv(*curve), 1e-10);
+    BOOST_CHECK_THROW(engine.theta(-1), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,84 @@
+#define BOOST_TEST_MODULE ZSpreadTest
+#include <boost/test/unit_test.hpp>
+#include "../z_spread_solver.hpp"
+#include "../bond.hpp"
+#include "../discount_curve.hpp"
+#include "../instrument_description.hpp"
+#include "../zero_coupon_curve.hpp"
+#include <memory>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(ZSpreadSuite)
+
+static std::shared_ptr<ZeroCouponCurve> testCurve() {
+    return std::make_shared<ZeroCouponCurve>(
+        std::vector<double>{3.0, 3.4, 3.8, 4.1, 4.3, 4.5},
+        std::vector<double>{0.5, 1.0, 2.0, 3.0, 5.0, 10.0});
+}
+
+static std::unique_ptr<Bond> makeBond(int i, std::shared_ptr<ZeroCouponCurve> curve) {
+    InstrumentDescription desc(InstrumentDescription::bond);
+    int years = 1 + i % 10;
+    desc.maturity = years;
+    desc.couponRate = 0.02 + 0.0005 * (i % 60);
+    desc.frequency = 2.0;
+    desc.notional = 100;
+    desc.issueDate = boost::gregorian::date(2024, 1, 1);
+    for (int k = 1; k <= 2 * years; ++k) desc.couponDates.push_back(0.5 * k);
+    desc.zeroCouponCurve = curve;
+    return std::make_unique<Bond>(desc);
+}
+
+BOOST_AUTO_TEST_CASE(TestRecoversKnownSpreads) {
+    auto curve = testCurve();
+    std::vector<std::unique_ptr<Bond>> book;
+    std::vector<const Bond*> bonds;
+    std::vector<double> prices, spreads;
+    for (int i = 0; i < 2000; ++i) {
+        book.push_back(makeBond(i, curve));
+        bonds.push_back(book.back().get());
+        double spread = -0.005 + 0.00002 * i;   // de -50pb a +350pb
+        spreads.push_back(spread);
+        prices.push_back(book.back()->presentValue(makeSpreadCurve(*curve, spread)));
+    }
+
+    ZSpreadSolver solver;
+    std::vector<ZSpreadResult> results = solver.solve(bonds, prices, *curve);
+    BOOST_REQUIRE_EQUAL(results.size(), bonds.size());
+
+    int maxIterations = 0;
+    for (std::size_t k = 0; k < bonds.size(); ++k) {
+        BOOST_CHECK_EQUAL(results[k].status, ZSpreadResult::Converged);
+        BOOST_CHECK_SMALL(results[k].spread - spreads[k], 1e-12);
+        BondRisk risk = bonds[k]->risk(makeSpreadCurve(*curve, spreads[k]));
+        BOOST_CHECK_CLOSE(results[k].spreadDuration, risk.modifiedDuration, 1e-8);
+        maxIterations = std::max(maxIterations, results[k].iterations);
+    }
+    BOOST_CHECK_LE(maxIterations, 10);
+}
+
+BOOST_AUTO_TEST_CASE(TestPriceAtCurveGivesZeroSpread) {
+    auto curve = testCurve();
+    auto bond = makeBond(7, curve);
+    std::vector<ZSpreadResult> results =
+        ZSpreadSolver().solve({bond.get()}, {bond->presentValue(*curve)}, *curve);
+    BOOST_CHECK_SMALL(results[0].spread, 1e-14);
+    BOOST_CHECK_EQUAL(results[0].iterations, 1);
+}
+
+BOOST_AUTO_TEST_CASE(TestInvalidInputs) {
+    auto curve = testCurve();
+    auto bond = makeBond(3, curve);
+    ZSpreadSolver solver;
+
+    std::vector<ZSpreadResult> results = solver.solve({bond.get()}, {-1.0}, *curve);
+    BOOST_CHECK_EQUAL(results[0].status, ZSpreadResult::NoSolution);
+
+    BOOST_CHECK_THROW(solver.solve({bond.get()}, {}, *curve), std::invalid_argument);
+
+    // Sin iteraciones suficientes se informa el estado
+    std::vector<ZSpreadResult> limited = ZSpreadSolver(1e-15, 1).solve({bond.get()}, {80.0}, *curve);
+    BOOST_CHECK_EQUAL(limited[0].status, ZSpreadResult::MaxIterations);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
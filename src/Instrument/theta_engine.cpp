@@ -0,0 +1,52 @@
+#include "theta_engine.hpp"
+#include <stdexcept>
+
+ThetaEngine::ThetaEngine(std::shared_ptr<ZeroCouponCurve> curve, RollMode mode)
+    : curve_(std::move(curve)), mode_(mode) {
+    if (!curve_) {
+        throw std::invalid_argument("ThetaEngine necesita una curva");
+    }
+}
+
+void ThetaEngine::add(const Bond& bond) {
+    positions_.push_back({&bond, nullptr, bond.presentValue(*curve_)});
+}
+
+void ThetaEngine::add(const Swap& swap) {
+    positions_.push_back({nullptr, &swap, swap.npv(*curve_)});
+}
+
+HorizonValue ThetaEngine::valueAt(const Position& position, const ZeroCouponCurve& rolled,
+                                  double horizon) const {
+    if (position.bond) {
+        return position.bond->valueAt(rolled, horizon);
+    }
+    return position.swap->valueAt(rolled, *curve_, horizon);
+}
+
+std::vector<ThetaResult> ThetaEngine::theta(int days) const {
+    if (days < 0) {
+        throw std::invalid_argument("El horizonte de theta debe ser no negativo");
+    }
+    double horizon = days / 360.0;
+
+    // La curva desplazada se construye una sola vez para toda la cartera
+    std::shared_ptr<ZeroCouponCurve> rolled =
+        mode_ == RollMode::ForwardImplied ? curve_->rolledForward(days) : curve_;
+
+    std::vector<ThetaResult> results;
+    results.reserve(positions_.size());
+    for (const Position& position : positions_) {
+        HorizonValue value = valueAt(position, *rolled, horizon);
+        results.push_back({position.pv, value.pv, value.paid, value.pv + value.paid - position.pv});
+    }
+    return results;
+}
+
+double ThetaEngine::bookTheta(int days) const {
+    double total = 0.0;
+    for (const ThetaResult& result : theta(days)) {
+        total += result.theta;
+    }
+    return total;
+}
@@ -0,0 +1,59 @@
+#ifndef THETA_ENGINE_HPP
+#define THETA_ENGINE_HPP
+
+#include "bond.hpp"
+#include "swap.hpp"
+#include "zero_coupon_curve.hpp"
+#include <memory>
+#include <vector>
+
+// Theta de un instrumento para un horizonte de N días
+struct ThetaResult {
+    double pv;         // Valor hoy
+    double rolledPv;   // Valor en la fecha desplazada
+    double paid;       // Flujos cobrados (+) o pagados (-) entre hoy y el horizonte
+    double theta;      // rolledPv + paid - pv
+};
+
+/* Carry y roll-down de una cartera sin reconstruir instrumentos ni recalibrar.
+ *
+ * Los instrumentos conservan sus tiempos de flujo precalculados; para un
+ * horizonte h se valoran con valueAt(), que desplaza los tiempos a t - h y
+ * descarta lo ya pagado. La curva en el horizonte depende del modo:
+ *  - RollDown: la curva conserva su forma (mismas tasas por plazo).
+ *  - ForwardImplied: se realizan los forwards de hoy, DF'(t) = DF(t + h) / DF(h).
+ *
+ * Los instrumentos se referencian por dirección y deben sobrevivir al motor.
+ */
+class ThetaEngine {
+public:
+    enum class RollMode { RollDown, ForwardImplied };
+
+    ThetaEngine(std::shared_ptr<ZeroCouponCurve> curve, RollMode mode = RollMode::RollDown);
+
+    void add(const Bond& bond);
+    void add(const Swap& swap);
+
+    std::size_t size() const { return positions_.size(); }
+
+    // Theta por instrumento, en el orden en que se añadieron
+    std::vector<ThetaResult> theta(int days) const;
+
+    // Suma de theta de toda la cartera
+    double bookTheta(int days) const;
+
+private:
+    struct Position {
+        const Bond* bond;
+        const Swap* swap;
+        double pv;   // Valor hoy, calculado al añadir
+    };
+
+    HorizonValue valueAt(const Position& position, const ZeroCouponCurve& rolled, double horizon) const;
+
+    std::shared_ptr<ZeroCouponCurve> curve_;
+    RollMode mode_;
+    std::vector<Position> positions_;
+};
+
+#endif // THETA_ENGINE_HPP
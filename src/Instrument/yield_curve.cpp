@@ -16,19 +16,7 @@ YieldCurve::YieldCurve() : zeroCouponBondPrices{}, maturities{} {}
      * @return The corresponding discount factor.
      */
     double YieldCurve::getZero(double accrualFraction) const {
-    if (accrualFraction <= maturities.front()) return zeroCouponBondPrices.front();
-    if (accrualFraction >= maturities.back()) return zeroCouponBondPrices.back();
-
-    auto it = std::lower_bound(maturities.begin(), maturities.end(), accrualFraction);
-    size_t index = std::distance(maturities.begin(), it);
-
-    if (index == 0) return zeroCouponBondPrices.front();
-    
-    // Interpolación lineal
-    double x0 = maturities[index - 1], x1 = maturities[index];
-    double y0 = zeroCouponBondPrices[index - 1], y1 = zeroCouponBondPrices[index];
-
-    return y0 + (accrualFraction - x0) * (y1 - y0) / (x1 - x0);
+    return interpolateDiscount(maturities, zeroCouponBondPrices, accrualFraction);
 }
    /* double YieldCurve::getZero(double accrualFraction) const {
         auto it = std::lower_bound(maturities.begin(), maturities.end(), accrualFraction);
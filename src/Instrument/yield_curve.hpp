@@ -1,5 +1,9 @@
+#ifndef YIELD_CURVE_HPP
+#define YIELD_CURVE_HPP
+
 #include <vector>
 #include <cmath>
+#include "discount_curve.hpp"
 /**
  * Class representing a yield curve for zero-coupon bonds.
  */
@@ -23,4 +27,11 @@ public:
      * @return The corresponding discount factor.
      */
     double getZero(double accrualFraction) const;
+
+    /**
+     * Same lookup as getZero, under the name expected by the pricing kernels.
+     */
+    double getDiscountFactor(double accrualFraction) const { return getZero(accrualFraction); }
 };
+
+#endif // YIELD_CURVE_HPP
@@ -0,0 +1,138 @@
+#ifndef Z_SPREAD_SOLVER_HPP
+#define Z_SPREAD_SOLVER_HPP
+
+#include "bond.hpp"
+#include "fast_math.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+// Resultado del Z-spread de un bono
+struct ZSpreadResult {
+    enum Status { Converged, MaxIterations, NoSolution };
+
+    double spread = 0.0;          // Spread continuo sobre la curva (decimal)
+    double spreadDuration = 0.0;  // -(1/P) dP/ds en el spread solución
+    int iterations = 0;
+    Status status = NoSolution;
+};
+
+/* Z-spread en lote: el spread s tal que Σ CF_i * DF(t_i) * exp(-s t_i) = P.
+ *
+ * Los flujos de cada bono se descuentan con la curva base una sola vez
+ * (b_i = CF_i * DF(t_i)) y se guardan en columnas contiguas para todos los
+ * bonos. Después cada iteración de Newton recorre todos los bonos aún sin
+ * converger con la derivada analítica f'(s) = -Σ t_i b_i exp(-s t_i), sin
+ * volver a consultar la curva. f es convexa y decreciente, así que Newton
+ * desde s = 0 converge sin necesidad de acotar la raíz.
+ */
+class ZSpreadSolver {
+public:
+    explicit ZSpreadSolver(double tolerance = 1e-12, int maxIterations = 50)
+        : tolerance_(tolerance), maxIterations_(maxIterations) {}
+
+    // prices[k] es el precio sucio del bono k (mismo nominal que sus flujos)
+    template<typename Curve>
+    void solve(const std::vector<const Bond*>& bonds, const std::vector<double>& prices,
+               const Curve& curve, std::vector<ZSpreadResult>& results) const;
+
+    template<typename Curve>
+    std::vector<ZSpreadResult> solve(const std::vector<const Bond*>& bonds,
+                                     const std::vector<double>& prices, const Curve& curve) const {
+        std::vector<ZSpreadResult> results;
+        solve(bonds, prices, curve, results);
+        return results;
+    }
+
+private:
+    double tolerance_;
+    int maxIterations_;
+};
+
+template<typename Curve>
+void ZSpreadSolver::solve(const std::vector<const Bond*>& bonds, const std::vector<double>& prices,
+                          const Curve& curve, std::vector<ZSpreadResult>& results) const {
+    if (bonds.size() != prices.size()) {
+        throw std::invalid_argument("Debe haber un precio por bono");
+    }
+    const std::size_t n = bonds.size();
+    results.assign(n, ZSpreadResult());
+
+    // Flujos descontados con la curva base, en columnas para todos los bonos
+    std::vector<std::size_t> offsets(n + 1, 0);
+    for (std::size_t k = 0; k < n; ++k) {
+        offsets[k + 1] = offsets[k] + bonds[k]->getCashflowTimes().size();
+    }
+    std::vector<double> times(offsets[n]);
+    std::vector<double> discounted(offsets[n]);
+    for (std::size_t k = 0; k < n; ++k) {
+        const std::vector<double>& t = bonds[k]->getCashflowTimes();
+        const std::vector<double>& amounts = bonds[k]->getCashflowAmounts();
+        for (std::size_t i = 0; i < t.size(); ++i) {
+            times[offsets[k] + i] = t[i];
+            discounted[offsets[k] + i] = amounts[i] * curve.getDiscountFactor(t[i]);
+        }
+    }
+
+    // exp(-s t_i) de los flujos de un bono, con la exp vectorizada en lote
+    std::vector<double> factors(offsets[n]);
+    auto spreadFactors = [&](double s, std::size_t k) {
+        for (std::size_t i = offsets[k]; i < offsets[k + 1]; ++i) factors[i] = -s * times[i];
+        fastmath::exp(factors.data() + offsets[k], factors.data() + offsets[k], offsets[k + 1] - offsets[k]);
+    };
+
+    // Bonos activos: los que aún iteran
+    std::vector<std::size_t> active;
+    active.reserve(n);
+    for (std::size_t k = 0; k < n; ++k) {
+        if (prices[k] > 0.0 && offsets[k + 1] > offsets[k]) active.push_back(k);
+    }
+
+    for (int iteration = 1; iteration <= maxIterations_ && !active.empty(); ++iteration) {
+        std::size_t remaining = 0;
+        for (std::size_t k : active) {
+            ZSpreadResult& result = results[k];
+            double s = result.spread;
+            double value = 0.0, slope = 0.0;
+            spreadFactors(s, k);
+            for (std::size_t i = offsets[k]; i < offsets[k + 1]; ++i) {
+                double pv = discounted[i] * factors[i];
+                value += pv;
+                slope -= times[i] * pv;
+            }
+            result.iterations = iteration;
+
+            double error = value - prices[k];
+            if (!std::isfinite(error) || slope >= 0.0) {
+                result.status = ZSpreadResult::NoSolution;
+                continue;
+            }
+            double step = error / slope;
+            result.spread = s - step;
+            result.spreadDuration = -slope / value;
+            if (std::abs(step) <= tolerance_ * (1.0 + std::abs(result.spread))) {
+                result.status = ZSpreadResult::Converged;
+                continue;
+            }
+            result.status = ZSpreadResult::MaxIterations;
+            active[remaining++] = k;
+        }
+        active.resize(remaining);
+    }
+
+    // Duración en el spread final
+    for (std::size_t k = 0; k < n; ++k) {
+        ZSpreadResult& result = results[k];
+        if (result.status != ZSpreadResult::Converged) continue;
+        double value = 0.0, weighted = 0.0;
+        spreadFactors(result.spread, k);
+        for (std::size_t i = offsets[k]; i < offsets[k + 1]; ++i) {
+            double pv = discounted[i] * factors[i];
+            value += pv;
+            weighted += times[i] * pv;
+        }
+        result.spreadDuration = weighted / value;
+    }
+}
+
+#endif // Z_SPREAD_SOLVER_HPP
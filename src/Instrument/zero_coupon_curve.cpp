@@ -1,11 +1,13 @@
 #include "zero_coupon_curve.hpp"
+#include "fast_math.hpp"
 #include <cmath>
 #include <algorithm>
 #include <stdexcept>
+#include <atomic>
 
 // Constructor para bonos (maturities en años)
 ZeroCouponCurve::ZeroCouponCurve(const std::vector<double>& zeroRates, const std::vector<double>& maturities)
-    : zeroRates(zeroRates), maturities(maturities) {
+    : zeroRates(zeroRates), maturities(maturities), version_(nextVersion()) {
     computeDiscountFactors();
 }
 
@@ -13,7 +15,7 @@ ZeroCouponCurve::ZeroCouponCurve(const std::vector<double>& zeroRates, const std
 ZeroCouponCurve::ZeroCouponCurve(const boost::gregorian::date& issueDate,
                                  const std::vector<double>& zeroRates,
                                  const std::vector<boost::gregorian::date>& dates)
-    : issueDate(issueDate), zeroRates(zeroRates), dates(dates) {
+    : issueDate(issueDate), zeroRates(zeroRates), dates(dates), version_(nextVersion()) {
     maturities.resize(dates.size());
     for (size_t i = 0; i < dates.size(); ++i) {
         maturities[i] = computeYearFraction(issueDate, dates[i]);
@@ -21,6 +23,37 @@ ZeroCouponCurve::ZeroCouponCurve(const boost::gregorian::date& issueDate,
     computeDiscountFactors();
 }
 
+std::uint64_t ZeroCouponCurve::nextVersion() {
+    static std::atomic<std::uint64_t> counter{0};
+    return ++counter;
+}
+
+void ZeroCouponCurve::updateZeroRates(const std::vector<double>& newZeroRates) {
+    if (published_.value)
+        throw std::logic_error("La curva está publicada en un CurveHandle: hay que publicar una curva nueva.");
+    if (newZeroRates.size() != maturities.size())
+        throw std::invalid_argument("Número de tasas distinto al número de pilares de la curva.");
+    zeroRates = newZeroRates;
+    computeDiscountFactors();
+    version_ = nextVersion();
+}
+
+std::shared_ptr<ZeroCouponCurve> ZeroCouponCurve::rolledForward(int days) const {
+    double horizon = days / 360.0;
+    double horizonDiscount = getDiscountFactor(horizon);
+
+    auto rolled = std::make_shared<ZeroCouponCurve>(*this);
+    rolled->issueDate = issueDate + boost::gregorian::days(days);
+    for (auto& date : rolled->dates) date += boost::gregorian::days(days);
+    for (size_t i = 0; i < maturities.size(); ++i) {
+        double df = getDiscountFactor(maturities[i] + horizon) / horizonDiscount;
+        rolled->zeroRates[i] = -fastmath::log(df) / maturities[i] * 100.0;
+    }
+    rolled->computeDiscountFactors();
+    rolled->version_ = nextVersion();
+    return rolled;
+}
+
 double ZeroCouponCurve::computeYearFraction(const boost::gregorian::date& start, const boost::gregorian::date& end) const {
     return (end - start).days() / 360.0;
 }
@@ -29,30 +62,15 @@ void ZeroCouponCurve::computeDiscountFactors() {
     discountFactors.resize(maturities.size());
     for (size_t i = 0; i < maturities.size(); ++i) {
         double zcRate = zeroRates[i] / 100.0;
-        discountFactors[i] = std::exp(-zcRate * maturities[i]);
+        discountFactors[i] = -zcRate * maturities[i];
     }
-}
-
-double ZeroCouponCurve::getDiscountFactor(double accrualFraction) const {
-    if (accrualFraction <= maturities.front()) return discountFactors.front();
-    if (accrualFraction >= maturities.back()) return discountFactors.back();
-
-    auto it = std::lower_bound(maturities.begin(), maturities.end(), accrualFraction);
-    size_t index = std::distance(maturities.begin(), it);
-
-    if (index == 0) return discountFactors.front();
-
-    // Interpolación lineal
-    double x0 = maturities[index - 1], x1 = maturities[index];
-    double y0 = discountFactors[index - 1], y1 = discountFactors[index];
-
-    return y0 + (accrualFraction - x0) * (y1 - y0) / (x1 - x0);
+    fastmath::exp(discountFactors.data(), discountFactors.data(), discountFactors.size());
 }
 
 double ZeroCouponCurve::getSpotRate(double accrualFraction, int frequency) const {
     if (accrualFraction <= maturities.front()) {
         double zcRate = zeroRates.front() / 100.0;
-        return frequency * (std::exp(zcRate / frequency) - 1) * 100.0;
+        return frequency * (fastmath::exp(zcRate / frequency) - 1) * 100.0;
     }
 
     auto it = std::lower_bound(maturities.begin(), maturities.end(), accrualFraction);
@@ -68,7 +86,7 @@ double ZeroCouponCurve::getSpotRate(double accrualFraction, int frequency) const
         double ZCi_1 = zeroRates[index - 1] / 100.0;
 
         double RF = (ZCi * Ti - ZCi_1 * Ti_1) / (Ti - Ti_1);
-        return frequency * (std::exp(RF / frequency) - 1) * 100.0;
+        return frequency * (fastmath::exp(RF / frequency) - 1) * 100.0;
     } else {
         // Fecha intermedia: interpolar DF y recalcular rate
         double DF = getDiscountFactor(accrualFraction);
@@ -80,8 +98,8 @@ double ZeroCouponCurve::forwardRate(double start, double end) const {
     double DFstart = getDiscountFactor(start);
     double DFend = getDiscountFactor(end);
 
-    return -std::log(DFend / DFstart) / (end - start);
+    return -fastmath::log(DFend / DFstart) / (end - start);
 }
 double ZeroCouponCurve::continuousToEffective(double continuousRate, double frequency) const {
-    return frequency * (std::exp(continuousRate / frequency) - 1);
+    return frequency * (fastmath::exp(continuousRate / frequency) - 1);
 }
\ No newline at end of file
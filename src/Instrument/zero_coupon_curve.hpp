@@ -2,6 +2,9 @@
 #define ZERO_COUPON_CURVE_HPP
 
 #include <vector>
+#include <memory>
+#include <cstdint>
+#include "discount_curve.hpp"
 #include <boost/date_time/gregorian/gregorian.hpp>
 
 class ZeroCouponCurve {
@@ -14,19 +17,62 @@ public:
                     const std::vector<double>& zeroRates,
                     const std::vector<boost::gregorian::date>& dates);
 
-    double getDiscountFactor(double accrualFraction) const;
+    // Inline para que los kernels de pricing puedan expandir el lookup
+    double getDiscountFactor(double accrualFraction) const {
+        return interpolateDiscount(maturities, discountFactors, accrualFraction);
+    }
     double getSpotRate(double accrualFraction, int frequency) const;
     double forwardRate(double start, double end) const;
     double computeYearFraction(const boost::gregorian::date& start, const boost::gregorian::date& end) const;
     double continuousToEffective(double continuousRate, double frequency) const;
+
+    // Pilares de la curva
+    const boost::gregorian::date& getIssueDate() const { return issueDate; }
+    const std::vector<double>& getZeroRates() const { return zeroRates; }       // En porcentaje
+    const std::vector<double>& getMaturities() const { return maturities; }     // En años (ACT/360)
+    const std::vector<double>& getDiscountFactors() const { return discountFactors; }
+    const std::vector<boost::gregorian::date>& getDates() const { return dates; }
+
+    // Versión de la curva: cambia cada vez que se publica (o republica) la curva.
+    // Se toma de un contador global, así dos curvas distintas nunca comparten versión.
+    std::uint64_t version() const { return version_; }
+
+    // Curva vista desde issueDate + days manteniendo los mismos plazos de los pilares:
+    // DF'(t) = DF(t + h) / DF(h), con h = days / 360 (forwards implícitos de hoy)
+    std::shared_ptr<ZeroCouponCurve> rolledForward(int days) const;
+
+    // Republica la curva con nuevas tasas cero (mismos pilares) y asigna nueva versión.
+    // Modifica la curva en sitio: solo la puede usar el hilo dueño de la curva,
+    // sin lectores concurrentes. Una curva publicada en un CurveHandle es de solo
+    // lectura (lanza std::logic_error); para recalibrarla se publica una curva
+    // nueva (ver CurveCalibrator::recalibrate).
+    void updateZeroRates(const std::vector<double>& newZeroRates);
+
+    // Indica si la curva se ha publicado en algún CurveHandle
+    bool published() const { return published_.value; }
+
 private:
+    friend class CurveHandle;
+
+    // Marca de publicación. No se copia: la copia de una curva publicada es una
+    // curva nueva, todavía sin lectores.
+    struct PublishedFlag {
+        bool value = false;
+        PublishedFlag() = default;
+        PublishedFlag(const PublishedFlag&) {}
+        PublishedFlag& operator=(const PublishedFlag&) { return *this; }
+    };
+
     void computeDiscountFactors();
+    static std::uint64_t nextVersion();
 
     boost::gregorian::date issueDate;
     std::vector<double> zeroRates;
     std::vector<double> maturities;
     std::vector<boost::gregorian::date> dates;  // Solo se usa en swaps
     std::vector<double> discountFactors;
+    std::uint64_t version_;
+    PublishedFlag published_;
 };
 
 #endif
\ No newline at end of file